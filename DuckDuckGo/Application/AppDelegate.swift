@@ -106,7 +106,7 @@ final class AppDelegate: NSObject, NSApplicationDelegate {
         privacyStats: privacyStats,
         freemiumDBPPromotionViewCoordinator: freemiumDBPPromotionViewCoordinator
     )
-    let privacyStats: PrivacyStatsCollecting
+    let privacyStats: BlockedTrackersCounting
     let activeRemoteMessageModel: ActiveRemoteMessageModel
     let homePageSettingsModel = HomePage.Models.SettingsModel()
     let remoteMessagingClient: RemoteMessagingClient!
@@ -338,12 +338,12 @@ final class AppDelegate: NSObject, NSApplicationDelegate {
 
 #if DEBUG
         if NSApplication.runType.requiresEnvironment {
-            privacyStats = PrivacyStats(databaseProvider: PrivacyStatsDatabase(), errorEvents: PrivacyStatsErrorHandler())
+            privacyStats = BatchingPrivacyStats(store: PrivacyStats(databaseProvider: PrivacyStatsDatabase(), errorEvents: PrivacyStatsErrorHandler()))
         } else {
             privacyStats = MockPrivacyStats()
         }
 #else
-        privacyStats = PrivacyStats(databaseProvider: PrivacyStatsDatabase())
+        privacyStats = BatchingPrivacyStats(store: PrivacyStats(databaseProvider: PrivacyStatsDatabase()))
 #endif
         PixelKit.configureExperimentKit(featureFlagger: featureFlagger, eventTracker: ExperimentEventTracker(store: UserDefaults.appConfiguration))
     }
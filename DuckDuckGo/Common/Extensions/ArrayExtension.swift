@@ -34,6 +34,24 @@ extension Array {
         return Array(self[offset ..< endIndex])
     }
 
+    /// Returns the results of the transform in the order of the elements, transforming chunks of elements on all available cores.
+    /// Only worth it for transforms that are expensive, such as decryption, and safe to run concurrently.
+    func concurrentMap<T>(chunkSize: Int = 64, _ transform: (Element) -> T) -> [T] {
+        guard count > chunkSize else { return map(transform) }
+
+        var results = [T?](repeating: nil, count: count)
+        results.withUnsafeMutableBufferPointer { results in
+            let chunkCount = (count + chunkSize - 1) / chunkSize
+            // every chunk writes to its own range of the results
+            DispatchQueue.concurrentPerform(iterations: chunkCount) { chunk in
+                for index in chunk * chunkSize ..< Swift.min((chunk + 1) * chunkSize, count) {
+                    results[index] = transform(self[index])
+                }
+            }
+        }
+        return results.map { $0! }
+    }
+
     /// Map collection insertion indexes for a filtered collection into a non-filtered collection
     /// Used to skip `stub` or `pendingDeletion` object indices in a full (non-filtered) database
     /// items collection and use insertion indexes of a filtered collection, the one that‘s displaying non-stub, non-deleted items.
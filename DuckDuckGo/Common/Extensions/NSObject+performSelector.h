@@ -21,7 +21,21 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @interface NSObject (performSelector)
-- (id)performSelector:(SEL)selector withArguments:(NSArray *)arguments;
+
+/// Performs `selector` on the receiver, marshalling `arguments` according to the method's type encoding.
+///
+/// - Object arguments are passed as-is; `NSNull` is passed as `nil`.
+/// - Scalar arguments (including `BOOL`) are taken from `NSNumber`s.
+/// - Struct and pointer arguments are taken from `NSValue`s with a matching `objCType`.
+/// - Other pointer-sized arguments receive the argument object pointer itself.
+///
+/// Object return values are returned as-is, scalars are boxed in `NSNumber` and other types in `NSValue`.
+/// `void` methods return `nil`.
+///
+/// Method signatures are cached per class, and `NSInvocation`s are reused from a per-thread pool.
+///
+- (nullable id)performSelector:(SEL)selector withArguments:(NSArray *)arguments;
+
 @end
 
 NS_ASSUME_NONNULL_END
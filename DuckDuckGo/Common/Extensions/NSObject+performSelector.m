@@ -17,36 +17,279 @@
 //
 
 #import "NSObject+performSelector.h"
+#import <objc/runtime.h>
+#import <os/lock.h>
+
+static NSString * const InvocationPoolThreadDictionaryKey = @"com.duckduckgo.performSelector.invocationPool";
+static const NSUInteger InvocationPoolMaxSizePerSignature = 4;
+
+/// Skips method type qualifiers (const, in, out, bycopy...) that don't affect the memory layout.
+static const char *PerformSelectorSkipTypeQualifiers(const char *type) {
+    while (*type && strchr("rnNoORV", *type)) {
+        type++;
+    }
+    return type;
+}
+
+static BOOL PerformSelectorIsObjectType(const char *type) {
+    return type[0] == _C_ID || type[0] == _C_CLASS;
+}
+
+static BOOL PerformSelectorIsNumericType(const char *type) {
+    return type[0] != '\0' && type[1] == '\0' && strchr("cislqCISLQfdB", type[0]) != NULL;
+}
+
+/// Methods in the init, new, copy and mutableCopy families return retained objects (see the ARC method families).
+static BOOL PerformSelectorReturnsRetainedObject(SEL selector) {
+    const char *name = sel_getName(selector);
+    while (*name == '_') {
+        name++;
+    }
+
+    static const char * const families[] = { "init", "new", "copy", "mutableCopy" };
+    for (size_t i = 0; i < sizeof(families) / sizeof(families[0]); i++) {
+        size_t length = strlen(families[i]);
+        if (strncmp(name, families[i], length) == 0 && !islower(name[length])) {
+            return YES;
+        }
+    }
+
+    return NO;
+}
+
+#pragma mark - Method signature cache
+
+static NSMethodSignature *PerformSelectorCachedMethodSignature(id target, SEL selector) {
+    static NSMapTable<id, NSMapTable<id, NSMethodSignature *> *> *cache;
+    static os_unfair_lock lock = OS_UNFAIR_LOCK_INIT;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                          valueOptions:NSPointerFunctionsStrongMemory
+                                              capacity:0];
+    });
+
+    // Classes are never deallocated and selectors are interned, so both are used as opaque, unretained keys.
+    Class cls = object_getClass(target);
+
+    os_unfair_lock_lock(&lock);
+    NSMethodSignature *signature = [[cache objectForKey:(__bridge id)(__bridge void *)cls] objectForKey:(__bridge id)(void *)selector];
+    os_unfair_lock_unlock(&lock);
+
+    if (signature) {
+        return signature;
+    }
+
+    signature = [target methodSignatureForSelector:selector];
+    if (!signature) {
+        return nil;
+    }
+
+    os_unfair_lock_lock(&lock);
+    NSMapTable *selectors = [cache objectForKey:(__bridge id)(__bridge void *)cls];
+    if (!selectors) {
+        selectors = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                              valueOptions:NSPointerFunctionsStrongMemory
+                                                  capacity:0];
+        [cache setObject:selectors forKey:(__bridge id)(__bridge void *)cls];
+    }
+    [selectors setObject:signature forKey:(__bridge id)(void *)selector];
+    os_unfair_lock_unlock(&lock);
+
+    return signature;
+}
+
+#pragma mark - Invocation pool
+
+/// Per-thread pool of invocations keyed by (cached, thus stable) method signature.
+static NSMapTable<NSMethodSignature *, NSMutableArray<NSInvocation *> *> *PerformSelectorInvocationPool(void) {
+    NSMutableDictionary *threadDictionary = NSThread.currentThread.threadDictionary;
+    NSMapTable *pool = threadDictionary[InvocationPoolThreadDictionaryKey];
+
+    if (!pool) {
+        pool = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                         valueOptions:NSPointerFunctionsStrongMemory
+                                             capacity:0];
+        threadDictionary[InvocationPoolThreadDictionaryKey] = pool;
+    }
+
+    return pool;
+}
+
+/// Takes an invocation out of the pool so that reentrant calls never share one.
+static NSInvocation *PerformSelectorDequeueInvocation(NSMethodSignature *signature) {
+    NSMutableArray<NSInvocation *> *invocations = [PerformSelectorInvocationPool() objectForKey:signature];
+    NSInvocation *invocation = invocations.lastObject;
+
+    if (invocation) {
+        [invocations removeLastObject];
+        return invocation;
+    }
+
+    return [NSInvocation invocationWithMethodSignature:signature];
+}
+
+static void PerformSelectorEnqueueInvocation(NSInvocation *invocation) {
+    NSMapTable *pool = PerformSelectorInvocationPool();
+    NSMutableArray<NSInvocation *> *invocations = [pool objectForKey:invocation.methodSignature];
+
+    if (!invocations) {
+        invocations = [NSMutableArray array];
+        [pool setObject:invocations forKey:invocation.methodSignature];
+    }
+
+    if (invocations.count < InvocationPoolMaxSizePerSignature) {
+        // Don't keep the target alive while the invocation is sitting in the pool.
+        invocation.target = nil;
+        [invocations addObject:invocation];
+    }
+}
+
+#pragma mark - Marshalling
+
+static void PerformSelectorRaise(NSString *format, ...) NS_FORMAT_FUNCTION(1, 2);
+static void PerformSelectorRaise(NSString *format, ...) {
+    va_list args;
+    va_start(args, format);
+    NSString *reason = [[NSString alloc] initWithFormat:format arguments:args];
+    va_end(args);
+
+    [[[NSException alloc] initWithName:@"InvalidSelectorOrTarget" reason:reason userInfo:nil] raise];
+}
+
+/// Writes `number` into `buffer` as the scalar type described by `type`.
+static void PerformSelectorGetScalarValue(NSNumber *number, const char *type, void *buffer) {
+    switch (type[0]) {
+        case _C_CHR: *(char *)buffer = number.charValue; break;
+        case _C_INT: *(int *)buffer = number.intValue; break;
+        case _C_SHT: *(short *)buffer = number.shortValue; break;
+        case _C_LNG: *(long *)buffer = number.longValue; break;
+        case _C_LNG_LNG: *(long long *)buffer = number.longLongValue; break;
+        case _C_UCHR: *(unsigned char *)buffer = number.unsignedCharValue; break;
+        case _C_UINT: *(unsigned int *)buffer = number.unsignedIntValue; break;
+        case _C_USHT: *(unsigned short *)buffer = number.unsignedShortValue; break;
+        case _C_ULNG: *(unsigned long *)buffer = number.unsignedLongValue; break;
+        case _C_ULNG_LNG: *(unsigned long long *)buffer = number.unsignedLongLongValue; break;
+        case _C_FLT: *(float *)buffer = number.floatValue; break;
+        case _C_DBL: *(double *)buffer = number.doubleValue; break;
+        case _C_BOOL: *(bool *)buffer = number.boolValue; break;
+    }
+}
+
+static NSNumber *PerformSelectorScalarValue(const void *buffer, const char *type) {
+    switch (type[0]) {
+        case _C_CHR: return @(*(const char *)buffer);
+        case _C_INT: return @(*(const int *)buffer);
+        case _C_SHT: return @(*(const short *)buffer);
+        case _C_LNG: return @(*(const long *)buffer);
+        case _C_LNG_LNG: return @(*(const long long *)buffer);
+        case _C_UCHR: return @(*(const unsigned char *)buffer);
+        case _C_UINT: return @(*(const unsigned int *)buffer);
+        case _C_USHT: return @(*(const unsigned short *)buffer);
+        case _C_ULNG: return @(*(const unsigned long *)buffer);
+        case _C_ULNG_LNG: return @(*(const unsigned long long *)buffer);
+        case _C_FLT: return @(*(const float *)buffer);
+        case _C_DBL: return @(*(const double *)buffer);
+        case _C_BOOL: return @(*(const bool *)buffer);
+    }
+    return nil;
+}
+
+static void PerformSelectorSetArgument(NSInvocation *invocation, NSUInteger index, id argument) {
+    NSMethodSignature *signature = invocation.methodSignature;
+    const char *type = PerformSelectorSkipTypeQualifiers([signature getArgumentTypeAtIndex:index]);
+
+    if (argument == [NSNull null]) {
+        argument = nil;
+    }
+
+    if (PerformSelectorIsObjectType(type)) {
+        __unsafe_unretained id object = argument;
+        [invocation setArgument:&object atIndex:index];
+        return;
+    }
+
+    NSUInteger size = 0;
+    NSGetSizeAndAlignment(type, &size, NULL);
+    uint8_t buffer[size];
+    memset(buffer, 0, size);
+
+    if (argument == nil) {
+        // Missing and `NSNull` arguments are zero-filled.
+    } else if ([argument isKindOfClass:NSNumber.class] && PerformSelectorIsNumericType(type)) {
+        PerformSelectorGetScalarValue(argument, type, buffer);
+    } else if ([argument isKindOfClass:NSValue.class] && strcmp([argument objCType], type) == 0) {
+        // `void *` values are only unboxed for `void *` arguments: typed pointers and C++ references (WebKit SPI)
+        // need an `NSValue` of their exact type.
+        [(NSValue *)argument getValue:buffer size:size];
+    } else if (size == sizeof(id)) {
+        // Pointer-sized arguments we can't otherwise interpret receive the object pointer itself, as they always did.
+        __unsafe_unretained id object = argument;
+        memcpy(buffer, &object, sizeof(id));
+    } else {
+        PerformSelectorRaise(@"Argument %@ at index %lu doesn't match type %s", argument, (unsigned long)index - 2, type);
+    }
+
+    [invocation setArgument:buffer atIndex:index];
+}
+
+static id PerformSelectorReturnValue(NSInvocation *invocation) {
+    NSMethodSignature *signature = invocation.methodSignature;
+    const char *type = PerformSelectorSkipTypeQualifiers(signature.methodReturnType);
+
+    if (type[0] == _C_VOID || signature.methodReturnLength == 0) {
+        return nil;
+    }
+
+    if (PerformSelectorIsObjectType(type)) {
+        __unsafe_unretained id object;
+        [invocation getReturnValue:&object];
+
+        if (PerformSelectorReturnsRetainedObject(invocation.selector)) {
+            return CFBridgingRelease((__bridge CFTypeRef)object);
+        }
+        return object;
+    }
+
+    NSUInteger size = signature.methodReturnLength;
+    uint8_t buffer[size];
+    [invocation getReturnValue:buffer];
+
+    if (PerformSelectorIsNumericType(type)) {
+        return PerformSelectorScalarValue(buffer, type);
+    }
+
+    return [NSValue valueWithBytes:buffer objCType:type];
+}
 
 @implementation NSObject (performSelector)
 
 - (id)performSelector:(SEL)selector withArguments:(NSArray *)arguments {
-    NSMethodSignature *methodSignature = [self methodSignatureForSelector:selector];
+    NSMethodSignature *methodSignature = PerformSelectorCachedMethodSignature(self, selector);
 
     if (!methodSignature) {
-        [[[NSException alloc] initWithName:@"InvalidSelectorOrTarget" reason:[NSString stringWithFormat:@"Could not get method signature for selector %@ on %@", NSStringFromSelector(selector), self] userInfo:nil] raise];
+        PerformSelectorRaise(@"Could not get method signature for selector %@ on %@", NSStringFromSelector(selector), self);
+    }
+
+    NSUInteger argumentCount = methodSignature.numberOfArguments - 2; // Indices 0 and 1 are reserved for target and selector
+    if (arguments.count > argumentCount) {
+        PerformSelectorRaise(@"Too many arguments (%lu) for selector %@", (unsigned long)arguments.count, NSStringFromSelector(selector));
     }
 
-    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:methodSignature];
+    NSInvocation *invocation = PerformSelectorDequeueInvocation(methodSignature);
     [invocation setSelector:selector];
     [invocation setTarget:self];
 
-    for (NSInteger i = 0; i < arguments.count; i++) {
-        id argument = arguments[i];
-        [invocation setArgument:&argument atIndex:i + 2]; // Indices 0 and 1 are reserved for target and selector
+    for (NSUInteger i = 0; i < argumentCount; i++) {
+        PerformSelectorSetArgument(invocation, i + 2, i < arguments.count ? arguments[i] : nil);
     }
 
     [invocation invoke];
+    id returnValue = PerformSelectorReturnValue(invocation);
 
-    if (methodSignature.methodReturnLength > 0) {
-        id returnValue;
-        [invocation getReturnValue:&returnValue];
-
-        return returnValue;
-    }
+    PerformSelectorEnqueueInvocation(invocation);
 
-    return nil;
+    return returnValue;
 }
 
-
 @end
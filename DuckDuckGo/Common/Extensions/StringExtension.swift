@@ -66,7 +66,21 @@ extension String {
         "{": "&#123;",
         "}": "&#125;",
     ]
+
+    private static let unicodeHtmlEscapedBytes: [Bool] = {
+        var escapedBytes = [Bool](repeating: false, count: 256)
+        for character in unicodeHtmlCharactersMapping.keys {
+            if let byte = character.utf8.first {
+                escapedBytes[Int(byte)] = true
+            }
+        }
+        return escapedBytes
+    }()
+
     func escapedUnicodeHtmlString() -> String {
+        // all the escaped characters are ASCII, so most strings can be returned after a scan of their bytes
+        guard utf8.contains(where: { Self.unicodeHtmlEscapedBytes[Int($0)] }) else { return self }
+
         var result = ""
 
         for character in self {
@@ -558,7 +558,7 @@ extension URL {
             // trashed files are still accessible for some reason even after stopping access
             || fm.isInTrash(self)
             // other file is being saved at the same URL
-            || NSURL.activeSecurityScopedUrlUsages.contains(where: { $0.url !== self as NSURL && $0.url == self as NSURL })
+            || SandboxExtensionRetainCounter.shared.activeURLs().contains(where: { $0 !== self as NSURL && $0 == self as NSURL })
             || !isWritableLocation() { return }
 
         handler()
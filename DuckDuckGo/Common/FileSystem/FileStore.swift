@@ -24,6 +24,7 @@ protocol FileStore {
     func persist(_ data: Data, url: URL) -> Bool
     func loadData(at url: URL) -> Data?
     func loadData(at url: URL, decryptIfNeeded: Bool) -> Data?
+    func encrypt(_ data: Data) -> Data?
     func decrypt(_ data: Data) -> Data?
     func hasData(at url: URL) -> Bool
     func directoryContents(at path: String) throws -> [String]
@@ -70,6 +71,13 @@ final class EncryptedFileStore: FileStore {
         return decryptIfNeeded ? data.flatMap(decrypt(_:)) : data
     }
 
+    func encrypt(_ data: Data) -> Data? {
+        if let key = self.encryptionKey {
+            return try? DataEncryption.encrypt(data: data, key: key)
+        }
+        return data
+    }
+
     func decrypt(_ data: Data) -> Data? {
         if let key = self.encryptionKey {
             return try? DataEncryption.decrypt(data: data, key: key)
@@ -114,6 +122,10 @@ extension FileManager: FileStore {
         return decryptIfNeeded ? data.flatMap(decrypt(_:)) : data
     }
 
+    func encrypt(_ data: Data) -> Data? {
+        data
+    }
+
     func decrypt(_ data: Data) -> Data? {
         data
     }
@@ -30,4 +30,5 @@ extension Logger {
     static var updates = { Logger(subsystem: "Updates", category: "") }()
     static var tabPreview = { Logger(subsystem: "Tab Preview", category: "") }()
     static var maliciousSiteProtection = { Logger(subsystem: "Malsite Protection", category: "") }()
+    static var sandboxExtensions = { Logger(subsystem: "Sandbox Extensions", category: "") }()
 }
@@ -23,29 +23,29 @@ struct BookmarksExporter {
     let list: BookmarkList
 
     func exportBookmarksTo(url: URL) throws {
-        var content = [Template.header]
-        content.append(contentsOf: export(list.topLevelEntities, level: 1))
-        content.append(Template.footer)
-        try content.joined().write(to: url, atomically: true, encoding: .utf8)
+        let writer = try ExportFileWriter(url: url)
+        try writer.write(Template.header)
+        try export(list.topLevelEntities, level: 1, to: writer)
+        try writer.write(Template.footer)
+        try writer.finish()
     }
 
-    func export(_ entities: [BaseBookmarkEntity], level: Int) -> [String] {
-        var content = [String]()
+    /// Writes the entities as they're visited, so the document is never built in memory.
+    private func export(_ entities: [BaseBookmarkEntity], level: Int, to writer: ExportFileWriter) throws {
         for entity in entities {
             if let bookmark = entity as? Bookmark {
-                content.append(Template.bookmark(level: level,
-                                                 title: bookmark.title.escapedUnicodeHtmlString(),
-                                                 url: bookmark.url,
-                                                 isFavorite: bookmark.isFavorite))
+                try writer.write(Template.bookmark(level: level,
+                                                   title: bookmark.title.escapedUnicodeHtmlString(),
+                                                   url: bookmark.url,
+                                                   isFavorite: bookmark.isFavorite))
             }
 
             if let folder = entity as? BookmarkFolder {
-                content.append(Template.openFolder(level: level, named: folder.title))
-                content.append(contentsOf: export(folder.children, level: level + 1))
-                content.append(Template.closeFolder(level: level))
+                try writer.write(Template.openFolder(level: level, named: folder.title))
+                try export(folder.children, level: level + 1, to: writer)
+                try writer.write(Template.closeFolder(level: level))
             }
         }
-        return content
     }
 
 }
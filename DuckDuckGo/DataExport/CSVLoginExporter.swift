@@ -27,54 +27,50 @@ final class CSVLoginExporter {
     }
 
     private let secureVault: any AutofillSecureVault
-    private let fileStore: FileStore
 
-    init(secureVault: any AutofillSecureVault, fileStore: FileStore = FileManager.default) {
+    init(secureVault: any AutofillSecureVault) {
         self.secureVault = secureVault
-        self.fileStore = fileStore
     }
 
+    /// Writes every login as it's read from the vault, so the exported logins are never all held in memory.
     func exportVaultLogins(to url: URL) throws {
-        var credentialsToExport: [SecureVaultModels.WebsiteCredentials] = []
+        let writer = try ExportFileWriter(url: url)
+        try writer.write("\"title\",\"url\",\"username\",\"password\"")
 
-        do {
-            let accounts = try secureVault.accounts()
+        let accounts = try readFromVault { try secureVault.accounts() }
 
-            for account in accounts {
-                guard let accountID = account.id, let accountIDInt = Int64(accountID) else {
-                    continue
-                }
+        for account in accounts {
+            guard let accountID = account.id, let accountIDInt = Int64(accountID) else {
+                continue
+            }
 
-                if let credentials = try secureVault.websiteCredentialsFor(accountId: accountIDInt) {
-                    credentialsToExport.append(credentials)
-                }
+            if let credentials = try readFromVault({ try secureVault.websiteCredentialsFor(accountId: accountIDInt) }) {
+                try writer.write("\n" + csvRow(for: credentials))
             }
+        }
+
+        try writer.finish()
+    }
+
+    private func readFromVault<T>(_ read: () throws -> T) throws -> T {
+        do {
+            return try read()
         } catch {
             PixelKit.fire(DebugEvent(GeneralPixel.secureVaultError(error: error)))
             throw error
         }
-
-        try save(credentials: credentialsToExport, to: url)
     }
 
-    private func save(credentials: [SecureVaultModels.WebsiteCredentials], to url: URL) throws {
-        let credentialsAsCSVRows: [String] = credentials.compactMap { credential in
-            let title = credential.account.title ?? ""
-            let domain = credential.account.domain ?? ""
-            let username = credential.account.username ?? ""
-            let password = credential.password?.utf8String() ?? ""
-
-            // Ensure that exported passwords escape any quotes they contain
-            let escapedPassword = password.replacingOccurrences(of: "\"", with: "\\\"")
-
-            return "\"\(title)\",\"\(domain)\",\"\(username)\",\"\(escapedPassword)\""
-        }
+    private func csvRow(for credential: SecureVaultModels.WebsiteCredentials) -> String {
+        let title = credential.account.title ?? ""
+        let domain = credential.account.domain ?? ""
+        let username = credential.account.username ?? ""
+        let password = credential.password?.utf8String() ?? ""
 
-        let headerRow = ["\"title\",\"url\",\"username\",\"password\""]
-        let csvString = (headerRow + credentialsAsCSVRows).joined(separator: "\n")
+        // Ensure that exported passwords escape any quotes they contain
+        let escapedPassword = password.replacingOccurrences(of: "\"", with: "\\\"")
 
-        let stringData = csvString.utf8data
-        _ = fileStore.persist(stringData, url: url)
+        return "\"\(title)\",\"\(domain)\",\"\(username)\",\"\(escapedPassword)\""
     }
 
 }
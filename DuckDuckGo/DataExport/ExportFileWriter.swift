@@ -0,0 +1,106 @@
+//
+//  ExportFileWriter.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Writes an exported file through a fixed size buffer, so the exported document is never held in memory as a whole.
+///
+/// The file is written into an item replacement directory and only moved to its destination by `finish()`,
+/// so a failed export neither leaves a partial file behind nor replaces an existing file.
+final class ExportFileWriter {
+
+    static let defaultBufferCapacity = 64 * 1024
+
+    private let url: URL
+    private let itemReplacementDirectory: URL
+    private let temporaryURL: URL
+    private let fileHandle: FileHandle
+    private let fileManager: FileManager
+
+    private let bufferCapacity: Int
+    private var buffer: [UInt8]
+    private var isFinished = false
+
+    init(url: URL, bufferCapacity: Int = ExportFileWriter.defaultBufferCapacity, fileManager: FileManager = .default) throws {
+        self.url = url
+        self.fileManager = fileManager
+        self.bufferCapacity = bufferCapacity
+        self.buffer = []
+        self.buffer.reserveCapacity(bufferCapacity)
+
+        itemReplacementDirectory = try fileManager.url(for: .itemReplacementDirectory, in: .userDomainMask, appropriateFor: url, create: true)
+        temporaryURL = itemReplacementDirectory.appendingPathComponent(url.lastPathComponent)
+        do {
+            guard fileManager.createFile(atPath: temporaryURL.path, contents: nil) else {
+                throw CocoaError(.fileWriteUnknown, userInfo: [NSFilePathErrorKey: temporaryURL.path])
+            }
+            fileHandle = try FileHandle(forWritingTo: temporaryURL)
+        } catch {
+            try? fileManager.removeItem(at: itemReplacementDirectory)
+            throw error
+        }
+    }
+
+    deinit {
+        guard !isFinished else { return }
+        try? fileHandle.close()
+        try? fileManager.removeItem(at: itemReplacementDirectory)
+    }
+
+    func write(_ string: String) throws {
+        var string = string
+        try string.withUTF8 { try write($0) }
+    }
+
+    func write(_ bytes: UnsafeBufferPointer<UInt8>) throws {
+        assert(!isFinished)
+        if buffer.count + bytes.count > bufferCapacity {
+            try flush()
+        }
+        // chunks larger than the buffer are written as is
+        guard bytes.count < bufferCapacity else {
+            try fileHandle.write(contentsOf: UnsafeRawBufferPointer(bytes))
+            return
+        }
+        buffer.append(contentsOf: bytes)
+    }
+
+    /// Writes the buffered data and moves the file to its destination, replacing an existing file.
+    func finish() throws {
+        try flush()
+        try fileHandle.close()
+        isFinished = true
+        defer {
+            try? fileManager.removeItem(at: itemReplacementDirectory)
+        }
+
+        if fileManager.fileExists(atPath: url.path) {
+            _ = try fileManager.replaceItemAt(url, withItemAt: temporaryURL)
+        } else {
+            try fileManager.moveItem(at: temporaryURL, to: url)
+        }
+    }
+
+    private func flush() throws {
+        guard !buffer.isEmpty else { return }
+
+        try buffer.withUnsafeBytes { try fileHandle.write(contentsOf: $0) }
+        buffer.removeAll(keepingCapacity: true)
+    }
+
+}
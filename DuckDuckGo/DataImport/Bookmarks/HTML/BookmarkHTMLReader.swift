@@ -18,6 +18,7 @@
 
 import Foundation
 import BrowserServicesKit
+import os.log
 
 struct HTMLImportedBookmarks {
     let source: BookmarkImportSource?
@@ -64,6 +65,14 @@ final class BookmarkHTMLReader {
     }
 
     private func reallyReadBookmarks() throws -> HTMLImportedBookmarks {
+        // Files exported by browsers are read without building a DOM, which is much faster for large files
+        do {
+            let document = try BookmarkHTMLStreamReader.read(contentsOf: bookmarksFileURL)
+            return readBookmarks(from: document)
+        } catch {
+            Logger.dataImportExport.debug("Reading bookmarks HTML with tidy: \(String(describing: error))")
+        }
+
         //
         // Bookmarks HTML is not a valid HTML and needs to be fixed before parsing, hence `.documentTidyHTML`.
         // This, however, has a side effect of wrapping any `<p></p>` tags (otherwise irrelevant to
@@ -81,15 +90,7 @@ final class BookmarkHTMLReader {
 
         let firstFolder = try readFolder(cursor)
 
-        var other = [ImportedBookmarks.BookmarkOrFolder]()
-        if importSource == .duckduckgoWebKit {
-            if firstFolder.name.isEmpty {
-                other.append(contentsOf: firstFolder.children ?? [])
-            } else {
-                other.append(firstFolder)
-            }
-        }
-
+        var remainingItems = [ImportedBookmarks.BookmarkOrFolder]()
         while cursor != nil {
             let itemType: XMLNode.BookmarkItemType?
             if importSource?.supportsSafariBookmarksHTMLFormat == true {
@@ -106,8 +107,55 @@ final class BookmarkHTMLReader {
             guard let itemType else { break }
 
             let items = try readItem(itemType, at: cursor)
-            other.append(contentsOf: items)
+            remainingItems.append(contentsOf: items)
+        }
+
+        return makeImportedBookmarks(importSource: importSource, firstFolder: firstFolder, remainingItems: remainingItems)
+    }
+
+    /// Reads the streamed document the way the tidied document is read.
+    ///
+    private func readBookmarks(from document: BookmarkHTMLStreamReader.Document) -> HTMLImportedBookmarks {
+        let firstFolder: ImportedBookmarks.BookmarkOrFolder
+        let remainingItems: [ImportedBookmarks.BookmarkOrFolder]
+        var importSource: BookmarkImportSource?
+
+        if let rootListItems = document.rootListItems {
+            if let first = rootListItems.first, first.isFolder {
+                firstFolder = first
+                remainingItems = Array(rootListItems.dropFirst())
+            } else {
+                // bookmarks directly in the top-level list are read like a Safari export without a top-level folder
+                firstFolder = .folder(name: "", children: rootListItems)
+                remainingItems = []
+                importSource = .thirdPartyBrowser(.safari)
+            }
+        } else {
+            // top-level folders are in the Safari format
+            firstFolder = document.topLevelItems[0]
+            remainingItems = Array(document.topLevelItems.dropFirst())
+            importSource = .thirdPartyBrowser(.safari)
+        }
+
+        if document.isDDGBookmarksDocument {
+            importSource = .duckduckgoWebKit
+        }
+
+        return makeImportedBookmarks(importSource: importSource, firstFolder: firstFolder, remainingItems: remainingItems)
+    }
+
+    private func makeImportedBookmarks(importSource: BookmarkImportSource?,
+                                       firstFolder: ImportedBookmarks.BookmarkOrFolder,
+                                       remainingItems: [ImportedBookmarks.BookmarkOrFolder]) -> HTMLImportedBookmarks {
+        var other = [ImportedBookmarks.BookmarkOrFolder]()
+        if importSource == .duckduckgoWebKit {
+            if firstFolder.name.isEmpty {
+                other.append(contentsOf: firstFolder.children ?? [])
+            } else {
+                other.append(firstFolder)
+            }
         }
+        other.append(contentsOf: remainingItems)
 
         let bookmarkBar: ImportedBookmarks.BookmarkOrFolder
         if importSource == .duckduckgoWebKit {
@@ -0,0 +1,570 @@
+//
+//  BookmarkHTMLStreamReader.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import BrowserServicesKit
+import Common
+import Foundation
+
+/// Reads bookmarks HTML files in a single pass over the file bytes, without building a DOM.
+///
+/// `BookmarkHTMLReader` tidies the whole file into an `XMLDocument` first, which takes a lot of time and memory
+/// for files with many bookmarks. This reader only accepts the markup written by browsers exporting bookmarks:
+/// `<DL><p>` lists of `<DT><H3>` folders and `<DT><A>` bookmarks, either in a single top-level list or, like Safari
+/// exports, as top-level folders. It throws on anything tidy would have to repair or could read differently
+/// (misplaced tags or text, unknown entities, whitespace to be collapsed), so the file can be read with tidy instead.
+///
+struct BookmarkHTMLStreamReader {
+
+    struct Document {
+        /// Items of the top-level list, if the file has one.
+        let rootListItems: [ImportedBookmarks.BookmarkOrFolder]?
+        /// Top-level folders and bookmarks, if the file has no top-level list. The first item is always a folder.
+        let topLevelItems: [ImportedBookmarks.BookmarkOrFolder]
+        let isDDGBookmarksDocument: Bool
+    }
+
+    /// The markup is not necessarily invalid, but can't be read without tidying it up.
+    struct UnsupportedMarkupError: Error {
+        let reason: String
+        let offset: Int
+    }
+
+    static func read(contentsOf url: URL) throws -> Document {
+        let data = try Data(contentsOf: url, options: .mappedIfSafe)
+        return try read(data)
+    }
+
+    static func read(_ data: Data) throws -> Document {
+        try data.withUnsafeBytes { buffer in
+            var parser = Parser(bytes: buffer.bindMemory(to: UInt8.self))
+            return try parser.parse()
+        }
+    }
+}
+
+private struct Parser {
+
+    private typealias BookmarkOrFolder = ImportedBookmarks.BookmarkOrFolder
+
+    private enum Const {
+        static let ddgNamespaceAttributeName = "xmlns:duckduckgo"
+        static let ddgNamespaceValue = "https://duckduckgo.com/bookmarks"
+        static let ddgFavoriteAttributeName = "duckduckgo:favorite"
+        static let vivaldiSeparatorName = "---"
+        static let vivaldiSeparatorURL = "http://bookmark.placeholder.url/"
+    }
+
+    private enum Byte {
+        static let lessThan = UInt8(ascii: "<")
+        static let greaterThan = UInt8(ascii: ">")
+        static let slash = UInt8(ascii: "/")
+        static let exclamationMark = UInt8(ascii: "!")
+        static let questionMark = UInt8(ascii: "?")
+        static let equals = UInt8(ascii: "=")
+        static let ampersand = UInt8(ascii: "&")
+        static let semicolon = UInt8(ascii: ";")
+        static let numberSign = UInt8(ascii: "#")
+        static let doubleQuote = UInt8(ascii: "\"")
+        static let singleQuote = UInt8(ascii: "'")
+        static let backtick = UInt8(ascii: "`")
+        static let space = UInt8(ascii: " ")
+        static let tab = UInt8(ascii: "\t")
+        static let lineFeed = UInt8(ascii: "\n")
+        static let carriageReturn = UInt8(ascii: "\r")
+        static let hyphen = UInt8(ascii: "-")
+        static let underscore = UInt8(ascii: "_")
+        static let colon = UInt8(ascii: ":")
+    }
+
+    private struct Tag {
+        let name: String
+        let isClosing: Bool
+        let attributes: [String: String]
+    }
+
+    private enum Capture {
+        case folderName
+        case bookmark(urlString: String?, isDDGFavorite: Bool)
+        case ignoredText(tagName: String)
+    }
+
+    private let bytes: UnsafeBufferPointer<UInt8>
+    private var index = 0
+
+    /// Lists being read, with the name of their folder (`nil` for the top-level list).
+    private var openLists = [(folderName: String?, items: [BookmarkOrFolder])]()
+    private var rootListItems: [BookmarkOrFolder]?
+    private var topLevelItems = [BookmarkOrFolder]()
+    private var isDDGBookmarksDocument = false
+
+    /// Text being read, starting at `capturedTextStart`, up to the closing tag.
+    private var capture: Capture?
+    private var capturedTextStart = 0
+    /// Name of the folder whose list should follow.
+    private var pendingFolderName: String?
+    /// Browsers start every list with a paragraph, tidy reads lists without one differently.
+    private var expectsParagraph = false
+    /// Bookmark and folder descriptions are ignored.
+    private var allowsText = false
+
+    init(bytes: UnsafeBufferPointer<UInt8>) {
+        self.bytes = bytes
+    }
+
+    mutating func parse() throws -> BookmarkHTMLStreamReader.Document {
+        skipByteOrderMark()
+
+        while index < bytes.count {
+            guard bytes[index] == Byte.lessThan else {
+                let textStart = index
+                index = firstIndex(of: Byte.lessThan, from: index) ?? bytes.count
+                if capture == nil, !allowsText, !isWhitespace(textStart..<index) {
+                    throw unsupported("text outside of bookmarks and folder names", at: textStart)
+                }
+                continue
+            }
+
+            let tagStart = index
+            guard let tag = try readMarkup() else { continue }
+            try handle(tag, at: tagStart)
+        }
+
+        guard openLists.isEmpty, capture == nil, pendingFolderName == nil, !expectsParagraph else {
+            throw unsupported("unexpected end of file", at: index)
+        }
+        if let rootListItems {
+            guard topLevelItems.isEmpty, !rootListItems.isEmpty else {
+                throw unsupported("empty top-level list or items outside of it", at: index)
+            }
+        } else if topLevelItems.isEmpty {
+            throw unsupported("no bookmarks", at: index)
+        }
+
+        return .init(rootListItems: rootListItems, topLevelItems: topLevelItems, isDDGBookmarksDocument: isDDGBookmarksDocument)
+    }
+
+    // MARK: - Bookmarks structure
+
+    private mutating func handle(_ tag: Tag, at tagStart: Int) throws {
+        allowsText = false
+
+        if let capture {
+            try endCapture(capture, with: tag, textRange: capturedTextStart..<tagStart)
+            return
+        }
+
+        if expectsParagraph {
+            guard !tag.isClosing, tag.name == "p" else {
+                throw unsupported("list not starting with a paragraph", at: tagStart)
+            }
+            expectsParagraph = false
+            return
+        }
+
+        if pendingFolderName != nil {
+            if tag.isClosing && tag.name == "dt" {
+                return
+            }
+            guard !tag.isClosing, tag.name == "dl" else {
+                throw unsupported("folder name not followed by a list", at: tagStart)
+            }
+        }
+
+        switch (tag.name, tag.isClosing) {
+        case ("dl", false):
+            guard pendingFolderName != nil || (openLists.isEmpty && rootListItems == nil && topLevelItems.isEmpty) else {
+                throw unsupported("list without a folder name", at: tagStart)
+            }
+            openLists.append((pendingFolderName, []))
+            pendingFolderName = nil
+            expectsParagraph = true
+
+        case ("dl", true):
+            guard let list = openLists.popLast() else {
+                throw unsupported("unbalanced list", at: tagStart)
+            }
+            if let folderName = list.folderName {
+                try append(.folder(name: folderName, children: list.items), at: tagStart)
+            } else {
+                rootListItems = list.items
+            }
+
+        case ("h3", false):
+            guard !openLists.isEmpty || rootListItems == nil else {
+                throw unsupported("folder after the top-level list", at: tagStart)
+            }
+            beginCapture(.folderName)
+
+        case ("a", false):
+            beginCapture(.bookmark(urlString: tag.attributes["href"], isDDGFavorite: tag.attributes[Const.ddgFavoriteAttributeName] == "true"))
+
+        case ("title", false), ("h1", false):
+            beginCapture(.ignoredText(tagName: tag.name))
+
+        case ("html", false):
+            isDDGBookmarksDocument = tag.attributes[Const.ddgNamespaceAttributeName] == Const.ddgNamespaceValue
+
+        case ("hr", false), ("dd", false):
+            // tidy could take these for the top-level folder
+            if openLists.count == 1, openLists[0].folderName == nil, openLists[0].items.isEmpty {
+                throw unsupported("<\(tag.name)> at the start of the top-level list", at: tagStart)
+            }
+            allowsText = tag.name == "dd"
+
+        case ("head", false), ("body", false), ("meta", false), ("dt", false), ("p", false),
+             ("html", true), ("head", true), ("body", true), ("meta", true), ("dt", true), ("dd", true), ("p", true), ("title", true), ("h1", true):
+            break
+
+        default:
+            throw unsupported("<\(tag.isClosing ? "/" : "")\(tag.name)>", at: tagStart)
+        }
+    }
+
+    private mutating func append(_ item: BookmarkOrFolder, at offset: Int) throws {
+        guard openLists.isEmpty else {
+            openLists[openLists.count - 1].items.append(item)
+            return
+        }
+
+        // top-level bookmarks are only read after a top-level folder, like in Safari exports
+        guard rootListItems == nil, item.isFolder || !topLevelItems.isEmpty else {
+            throw unsupported("bookmark outside of a list", at: offset)
+        }
+        topLevelItems.append(item)
+    }
+
+    private mutating func beginCapture(_ capture: Capture) {
+        self.capture = capture
+        capturedTextStart = index
+    }
+
+    private mutating func endCapture(_ capture: Capture, with tag: Tag, textRange: Range<Int>) throws {
+        switch capture {
+        case .folderName where tag.isClosing && tag.name == "h3":
+            pendingFolderName = try readText(in: textRange)
+
+        case .bookmark(let urlString, let isDDGFavorite) where tag.isClosing && tag.name == "a":
+            let name = try readText(in: textRange)
+            if !(name == Const.vivaldiSeparatorName && urlString == Const.vivaldiSeparatorURL) {
+                try append(.bookmark(name: name, urlString: urlString, isDDGFavorite: isDDGFavorite), at: textRange.lowerBound)
+            }
+
+        case .ignoredText(let tagName) where tag.isClosing && tag.name == tagName:
+            break
+
+        default:
+            throw unsupported("<\(tag.isClosing ? "/" : "")\(tag.name)> inside a bookmark or folder name", at: textRange.upperBound)
+        }
+        self.capture = nil
+    }
+
+    /// Reads a bookmark or folder name, which is trimmed by `BookmarkOrFolder`.
+    private func readText(in range: Range<Int>) throws -> String {
+        let text = try string(in: range)
+        // tidy collapses whitespace within the text
+        let trimmedText = text.trimmingWhitespace()
+        guard !trimmedText.contains(where: { $0 == "\n" || $0 == "\r" || $0 == "\t" || $0 == "\u{00A0}" }),
+              !trimmedText.contains("  ") else {
+            throw unsupported("whitespace to be collapsed", at: range.lowerBound)
+        }
+        return text
+    }
+
+    // MARK: - Tokenizer
+
+    /// Reads the tag starting at `index`, or skips the comment or declaration starting there and returns `nil`.
+    private mutating func readMarkup() throws -> Tag? {
+        let start = index
+        index += 1
+
+        if hasPrefix("!--") {
+            guard let commentEnd = firstIndex(of: "-->", from: index + 3) else {
+                throw unsupported("unterminated comment", at: start)
+            }
+            index = commentEnd + 3
+            return nil
+        }
+        if index < bytes.count, bytes[index] == Byte.exclamationMark || bytes[index] == Byte.questionMark {
+            guard let declarationEnd = firstIndex(of: Byte.greaterThan, from: index) else {
+                throw unsupported("unterminated declaration", at: start)
+            }
+            index = declarationEnd + 1
+            return nil
+        }
+
+        let isClosing = index < bytes.count && bytes[index] == Byte.slash
+        if isClosing {
+            index += 1
+        }
+
+        let nameStart = index
+        while index < bytes.count, isNameByte(bytes[index]) {
+            index += 1
+        }
+        guard index > nameStart else {
+            throw unsupported("invalid tag", at: start)
+        }
+        let name = try string(in: nameStart..<index, decodingEntities: false).lowercased()
+
+        var attributes = [String: String]()
+        while true {
+            skipWhitespace()
+            guard index < bytes.count else {
+                throw unsupported("unterminated tag", at: start)
+            }
+
+            switch bytes[index] {
+            case Byte.greaterThan:
+                index += 1
+                return Tag(name: name, isClosing: isClosing, attributes: attributes)
+            case Byte.slash:
+                index += 1
+            default:
+                let (attributeName, value) = try readAttribute()
+                if attributes[attributeName] == nil {
+                    attributes[attributeName] = value
+                }
+            }
+        }
+    }
+
+    private mutating func readAttribute() throws -> (name: String, value: String) {
+        let nameStart = index
+        while index < bytes.count, isAttributeNameByte(bytes[index]) {
+            index += 1
+        }
+        guard index > nameStart else {
+            throw unsupported("invalid attribute", at: nameStart)
+        }
+        let name = try string(in: nameStart..<index, decodingEntities: false).lowercased()
+
+        guard index < bytes.count, bytes[index] == Byte.equals else {
+            // attributes without a value (e.g. `FOLDED`) are never read
+            return (name, "")
+        }
+        index += 1
+
+        let valueRange: Range<Int>
+        if index < bytes.count, bytes[index] == Byte.doubleQuote || bytes[index] == Byte.singleQuote {
+            let quote = bytes[index]
+            guard let valueEnd = firstIndex(of: quote, from: index + 1) else {
+                throw unsupported("unterminated attribute value", at: nameStart)
+            }
+            valueRange = index + 1 ..< valueEnd
+            index = valueEnd + 1
+            // mismatched quotes, or URLs split into lines, repaired by tidy
+            if bytes[valueRange].contains(where: { $0 == Byte.lessThan || $0 == Byte.greaterThan || ($0 != Byte.space && isWhitespace($0)) }) {
+                throw unsupported("attribute value to be repaired", at: nameStart)
+            }
+        } else {
+            let valueStart = index
+            while index < bytes.count, !isWhitespace(bytes[index]), bytes[index] != Byte.greaterThan {
+                guard ![Byte.doubleQuote, Byte.singleQuote, Byte.backtick, Byte.lessThan].contains(bytes[index]) else {
+                    throw unsupported("attribute value to be repaired", at: nameStart)
+                }
+                index += 1
+            }
+            valueRange = valueStart..<index
+        }
+
+        return (name, try string(in: valueRange))
+    }
+
+    /// Decodes the UTF-8 text, along with the character references tidy would decode the same way.
+    ///
+    private func string(in range: Range<Int>, decodingEntities: Bool = true) throws -> String {
+        let slice = UnsafeBufferPointer(rebasing: bytes[range])
+
+        guard decodingEntities, slice.contains(Byte.ampersand) else {
+            guard let string = String(bytes: slice, encoding: .utf8) else {
+                throw unsupported("invalid UTF-8", at: range.lowerBound)
+            }
+            return string
+        }
+
+        var decoded = [UInt8]()
+        decoded.reserveCapacity(slice.count)
+        var position = range.lowerBound
+        while position < range.upperBound {
+            guard bytes[position] == Byte.ampersand else {
+                decoded.append(bytes[position])
+                position += 1
+                continue
+            }
+            position = try decodeCharacterReference(at: position, end: range.upperBound, into: &decoded)
+        }
+
+        guard let string = String(bytes: decoded, encoding: .utf8) else {
+            throw unsupported("invalid UTF-8", at: range.lowerBound)
+        }
+        return string
+    }
+
+    /// Decodes the character reference starting with the `&` at `start`, returning the position after it.
+    ///
+    private func decodeCharacterReference(at start: Int, end: Int, into decoded: inout [UInt8]) throws -> Int {
+        var position = start + 1
+
+        if position < end, bytes[position] == Byte.numberSign {
+            position += 1
+            let isHexadecimal = position < end && (bytes[position] | 0x20) == UInt8(ascii: "x")
+            if isHexadecimal {
+                position += 1
+            }
+            let digitsStart = position
+            while position < end, isHexadecimal ? isHexadecimalDigit(bytes[position]) : isDecimalDigit(bytes[position]) {
+                position += 1
+            }
+            guard position > digitsStart, position - digitsStart <= 8, position < end, bytes[position] == Byte.semicolon,
+                  let digits = String(bytes: UnsafeBufferPointer(rebasing: bytes[digitsStart..<position]), encoding: .ascii),
+                  let value = UInt32(digits, radix: isHexadecimal ? 16 : 10),
+                  // tidy maps control characters to Windows-1252, and may not keep whitespace
+                  value >= 0x20, !(0x7F...0xA0).contains(value),
+                  let scalar = Unicode.Scalar(value) else {
+                throw unsupported("character reference", at: start)
+            }
+            decoded.append(contentsOf: String(Character(scalar)).utf8)
+            return position + 1
+        }
+
+        let nameStart = position
+        while position < end, isAlphanumeric(bytes[position]) {
+            position += 1
+        }
+        let name = String(bytes: UnsafeBufferPointer(rebasing: bytes[nameStart..<position]), encoding: .ascii) ?? ""
+
+        if position < end, bytes[position] == Byte.semicolon, !name.isEmpty {
+            guard let character = Self.decodedEntities[name] else {
+                throw unsupported("entity &\(name);", at: start)
+            }
+            decoded.append(character)
+            return position + 1
+        }
+
+        // a bare ampersand, e.g. in a URL query, unless it could be read as an entity without the semicolon
+        guard !Self.htmlEntityNames.contains(name) else {
+            throw unsupported("entity &\(name)", at: start)
+        }
+        decoded.append(Byte.ampersand)
+        return start + 1
+    }
+
+    private static let decodedEntities: [String: UInt8] = [
+        "amp": Byte.ampersand,
+        "lt": Byte.lessThan,
+        "gt": Byte.greaterThan,
+        "quot": Byte.doubleQuote
+    ]
+
+    /// HTML 4 named character references.
+    private static let htmlEntityNames: Set<String> = [
+        "AElig", "Aacute", "Acirc", "Agrave", "Alpha", "Aring", "Atilde", "Auml", "Beta", "Ccedil", "Chi", "Dagger",
+        "Delta", "ETH", "Eacute", "Ecirc", "Egrave", "Epsilon", "Eta", "Euml", "Gamma", "Iacute", "Icirc", "Igrave",
+        "Iota", "Iuml", "Kappa", "Lambda", "Mu", "Ntilde", "Nu", "OElig", "Oacute", "Ocirc", "Ograve", "Omega",
+        "Omicron", "Oslash", "Otilde", "Ouml", "Phi", "Pi", "Prime", "Psi", "Rho", "Scaron", "Sigma", "THORN", "Tau",
+        "Theta", "Uacute", "Ucirc", "Ugrave", "Upsilon", "Uuml", "Xi", "Yacute", "Yuml", "Zeta", "aacute", "acirc",
+        "acute", "aelig", "agrave", "alefsym", "alpha", "amp", "and", "ang", "aring", "asymp", "atilde", "auml",
+        "bdquo", "beta", "brvbar", "bull", "cap", "ccedil", "cedil", "cent", "chi", "circ", "clubs", "cong", "copy",
+        "crarr", "cup", "curren", "dArr", "dagger", "darr", "deg", "delta", "diams", "divide", "eacute", "ecirc",
+        "egrave", "empty", "emsp", "ensp", "epsilon", "equiv", "eta", "eth", "euml", "euro", "exist", "fnof",
+        "forall", "frac12", "frac14", "frac34", "frasl", "gamma", "ge", "gt", "hArr", "harr", "hearts", "hellip",
+        "iacute", "icirc", "iexcl", "igrave", "image", "infin", "int", "iota", "iquest", "isin", "iuml", "kappa",
+        "lArr", "lambda", "lang", "laquo", "larr", "lceil", "ldquo", "le", "lfloor", "lowast", "loz", "lrm",
+        "lsaquo", "lsquo", "lt", "macr", "mdash", "micro", "middot", "minus", "mu", "nabla", "nbsp", "ndash", "ne",
+        "ni", "not", "notin", "nsub", "ntilde", "nu", "oacute", "ocirc", "oelig", "ograve", "oline", "omega",
+        "omicron", "oplus", "or", "ordf", "ordm", "oslash", "otilde", "otimes", "ouml", "para", "part", "permil",
+        "perp", "phi", "pi", "piv", "plusmn", "pound", "prime", "prod", "prop", "psi", "quot", "rArr", "radic",
+        "rang", "raquo", "rarr", "rceil", "rdquo", "real", "reg", "rfloor", "rho", "rlm", "rsaquo", "rsquo", "sbquo",
+        "scaron", "sdot", "sect", "shy", "sigma", "sigmaf", "sim", "spades", "sub", "sube", "sum", "sup", "sup1",
+        "sup2", "sup3", "supe", "szlig", "tau", "there4", "theta", "thetasym", "thinsp", "thorn", "tilde", "times",
+        "trade", "uArr", "uacute", "uarr", "ucirc", "ugrave", "uml", "upsih", "upsilon", "uuml", "weierp", "xi",
+        "yacute", "yen", "yuml", "zeta", "zwj", "zwnj"
+    ]
+
+    // MARK: - Bytes
+
+    private mutating func skipByteOrderMark() {
+        if hasPrefix("\u{FEFF}") {
+            index += 3
+        }
+    }
+
+    private mutating func skipWhitespace() {
+        while index < bytes.count, isWhitespace(bytes[index]) {
+            index += 1
+        }
+    }
+
+    private func hasPrefix(_ prefix: String) -> Bool {
+        let prefix = prefix.utf8
+        guard bytes.count - index >= prefix.count else { return false }
+        return zip(bytes[index...], prefix).allSatisfy { $0 == $1 }
+    }
+
+    private func firstIndex(of byte: UInt8, from start: Int) -> Int? {
+        guard start < bytes.count, let baseAddress = bytes.baseAddress,
+              let match = memchr(baseAddress + start, Int32(byte), bytes.count - start) else { return nil }
+        return UnsafeRawPointer(baseAddress).distance(to: match)
+    }
+
+    private func firstIndex(of string: String, from start: Int) -> Int? {
+        let pattern = Array(string.utf8)
+        var position = start
+        while let candidate = firstIndex(of: pattern[0], from: position) {
+            guard bytes.count - candidate >= pattern.count else { return nil }
+            if bytes[candidate..<candidate + pattern.count].elementsEqual(pattern) {
+                return candidate
+            }
+            position = candidate + 1
+        }
+        return nil
+    }
+
+    private func isWhitespace(_ range: Range<Int>) -> Bool {
+        bytes[range].allSatisfy(isWhitespace)
+    }
+
+    private func isWhitespace(_ byte: UInt8) -> Bool {
+        byte == Byte.space || byte == Byte.lineFeed || byte == Byte.carriageReturn || byte == Byte.tab
+    }
+
+    /// Any byte but whitespace, quotes and the bytes delimiting attributes and tags.
+    private func isAttributeNameByte(_ byte: UInt8) -> Bool {
+        !isWhitespace(byte) && ![Byte.equals, Byte.greaterThan, Byte.lessThan, Byte.slash, Byte.doubleQuote, Byte.singleQuote].contains(byte)
+    }
+
+    private func isNameByte(_ byte: UInt8) -> Bool {
+        isAlphanumeric(byte) || byte == Byte.colon || byte == Byte.hyphen || byte == Byte.underscore
+    }
+
+    private func isAlphanumeric(_ byte: UInt8) -> Bool {
+        isDecimalDigit(byte) || (UInt8(ascii: "a")...UInt8(ascii: "z")).contains(byte | 0x20)
+    }
+
+    private func isDecimalDigit(_ byte: UInt8) -> Bool {
+        (UInt8(ascii: "0")...UInt8(ascii: "9")).contains(byte)
+    }
+
+    private func isHexadecimalDigit(_ byte: UInt8) -> Bool {
+        isDecimalDigit(byte) || (UInt8(ascii: "a")...UInt8(ascii: "f")).contains(byte | 0x20)
+    }
+
+    private func unsupported(_ reason: String, at offset: Int) -> BookmarkHTMLStreamReader.UnsupportedMarkupError {
+        .init(reason: reason, offset: offset)
+    }
+}
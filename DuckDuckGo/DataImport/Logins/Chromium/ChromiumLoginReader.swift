@@ -70,6 +70,8 @@ final class ChromiumLoginReader {
     private static let sqlSelectWithCreatedTimestamp = "SELECT signon_realm, username_value, password_value, date_created, blacklisted_by_user FROM logins WHERE blacklisted_by_user != 1;"
     private static let sqlSelectWithoutTimestamp = "SELECT signon_realm, username_value, password_value, blacklisted_by_user FROM logins WHERE blacklisted_by_user != 1;"
 
+    private static let initializationVector = String(repeating: " ", count: 16).utf8data
+
     private let source: DataImport.Source
 
     init(chromiumDataDirectoryURL: URL,
@@ -179,23 +181,23 @@ final class ChromiumLoginReader {
 
         do {
             let queue = try DatabaseQueue(path: temporaryDatabaseURL.path)
-            var rows = [ChromiumCredential]()
 
+            // rows are deduplicated as they're fetched, without loading them all first
             try queue.read { database in
-                rows = try fetchCredentials(from: database)
-            }
-
-            for row in rows {
-                let existingRowTimestamp = loginRows[row.id]?.passwordModifiedAt
-                let newRowTimestamp = row.passwordModifiedAt
-
-                switch (newRowTimestamp, existingRowTimestamp) {
-                case let (.some(new), .some(existing)) where new > existing:
-                    loginRows[row.id] = row
-                case (_, .none):
-                    loginRows[row.id] = row
-                default:
-                    break
+                let rows = try fetchCredentials(from: database)
+
+                while let row = try rows.next() {
+                    let existingRowTimestamp = loginRows[row.id]?.passwordModifiedAt
+                    let newRowTimestamp = row.passwordModifiedAt
+
+                    switch (newRowTimestamp, existingRowTimestamp) {
+                    case let (.some(new), .some(existing)) where new > existing:
+                        loginRows[row.id] = row
+                    case (_, .none):
+                        loginRows[row.id] = row
+                    default:
+                        break
+                    }
                 }
             }
 
@@ -208,17 +210,23 @@ final class ChromiumLoginReader {
 
     private func createImportedLoginCredentials(from credentials: Dictionary<ChromiumCredential.ID, ChromiumCredential>.Values,
                                                 decryptionKey: Data) throws -> [ImportedLoginCredential] {
+        // the key is derived once, passwords are decrypted on all cores
+        let decryptionResults = Array(credentials).concurrentMap { row in
+            Result {
+                let decryptedPassword = try decrypt(passwordData: row.encryptedPassword, with: decryptionKey)
+                return ImportedLoginCredential(url: row.url, username: row.username, password: decryptedPassword)
+            }
+        }
+
         var lastError: Error?
-        let result = credentials.compactMap { row -> ImportedLoginCredential? in
-            let decryptedPassword: String
-            do {
-                decryptedPassword = try decrypt(passwordData: row.encryptedPassword, with: decryptionKey)
-            } catch {
+        let result = decryptionResults.compactMap { decryptionResult -> ImportedLoginCredential? in
+            switch decryptionResult {
+            case .success(let credential):
+                return credential
+            case .failure(let error):
                 lastError = error
                 return nil
             }
-
-            return ImportedLoginCredential(url: row.url, username: row.username, password: decryptedPassword)
         }
         if result.isEmpty, let lastError {
             throw lastError
@@ -226,22 +234,22 @@ final class ChromiumLoginReader {
         return result
     }
 
-    private func fetchCredentials(from database: GRDB.Database) throws -> [ChromiumCredential] {
+    private func fetchCredentials(from database: GRDB.Database) throws -> RecordCursor<ChromiumCredential> {
         do {
-            return try ChromiumCredential.fetchAll(database, sql: Self.sqlSelectWithPasswordTimestamp)
+            return try ChromiumCredential.fetchCursor(database, sql: Self.sqlSelectWithPasswordTimestamp)
         } catch let databaseError as DatabaseError {
             guard databaseError.isMissingColumnError else {
                 throw databaseError
             }
 
             do {
-                return try ChromiumCredential.fetchAll(database, sql: Self.sqlSelectWithCreatedTimestamp)
+                return try ChromiumCredential.fetchCursor(database, sql: Self.sqlSelectWithCreatedTimestamp)
             } catch let databaseError as DatabaseError {
                 guard databaseError.isMissingColumnError else {
                     throw databaseError
                 }
 
-                return try ChromiumCredential.fetchAll(database, sql: Self.sqlSelectWithoutTimestamp)
+                return try ChromiumCredential.fetchCursor(database, sql: Self.sqlSelectWithoutTimestamp)
             }
         }
     }
@@ -258,8 +266,7 @@ final class ChromiumLoginReader {
         guard passwordData.count >= 4 else { throw ImportError(type: .passwordDataTooShort, underlyingError: nil) }
 
         let trimmedPasswordData = passwordData[3...]
-        let iv = String(repeating: " ", count: 16).utf8data
-        let decrypted = try Cryptography.decryptAESCBC(data: trimmedPasswordData, key: key, iv: iv)
+        let decrypted = try Cryptography.decryptAESCBC(data: trimmedPasswordData, key: key, iv: Self.initializationVector)
 
         return try String(data: decrypted, encoding: .utf8) ?? { throw ImportError(type: .dataToStringConversionError, underlyingError: nil) }()
     }
@@ -0,0 +1,153 @@
+//
+//  ASN1DERReader.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Reads DER encoded ASN.1 elements one after another, in place.
+///
+/// Element contents are returned as slices of the data being read, without copying them, and sequences are read
+/// with a new reader over their contents, so no tree of nodes is built and nested elements are only read when needed.
+/// Every read validates the element tag and length, and returns `nil` without moving the reader if the next element
+/// is truncated, malformed or of another type.
+///
+/// See http://luca.ntop.org/Teaching/Appunti/asn1.html
+struct ASN1DERReader {
+
+    enum Tag: UInt8 {
+        case integer = 0x02
+        case bitString = 0x03
+        case octetString = 0x04
+        case null = 0x05
+        case objectIdentifier = 0x06
+        case sequence = 0x30
+    }
+
+    private let data: Data
+    private var position: Data.Index
+
+    /// Whether all the elements have been read
+    var isAtEnd: Bool {
+        position >= data.endIndex
+    }
+
+    init(data: Data) {
+        self.data = data
+        self.position = data.startIndex
+    }
+
+    /// Reads the next element of any type and returns its tag and contents.
+    mutating func readElement() -> (tag: UInt8, contents: Data)? {
+        guard let (tag, contentsRange) = element(at: position) else { return nil }
+
+        position = contentsRange.upperBound
+        return (tag, data[contentsRange])
+    }
+
+    /// Skips the next element of any type.
+    ///
+    /// - Returns: `false` if there is no valid element to skip
+    mutating func skipElement() -> Bool {
+        readElement() != nil
+    }
+
+    /// Reads the next element as a sequence.
+    ///
+    /// - Returns: A reader over the sequence elements
+    mutating func readSequence() -> ASN1DERReader? {
+        read(.sequence).map(ASN1DERReader.init(data:))
+    }
+
+    mutating func readOctetString() -> Data? {
+        read(.octetString)
+    }
+
+    mutating func readObjectIdentifier() -> Data? {
+        read(.objectIdentifier)
+    }
+
+    mutating func readNull() -> Bool {
+        guard let contents = peek(.null), contents.isEmpty else { return false }
+
+        position = contents.endIndex
+        return true
+    }
+
+    /// Reads the bytes of an integer as they are encoded, e.g. for an integer holding a key.
+    mutating func readIntegerBytes() -> Data? {
+        guard let contents = peek(.integer), !contents.isEmpty else { return nil }
+
+        position = contents.endIndex
+        return contents
+    }
+
+    /// Reads a non-negative integer of up to 4 bytes, e.g. an iteration count or a key length.
+    mutating func readInteger() -> Int? {
+        guard let contents = peek(.integer), let firstByte = contents.first, firstByte & 0x80 == 0 else { return nil }
+
+        let significantBytes = contents.drop { $0 == 0 }
+        guard significantBytes.count <= 4 else { return nil }
+
+        position = contents.endIndex
+        return significantBytes.reduce(0) { $0 << 8 | Int($1) }
+    }
+
+    // MARK: - Private
+
+    private mutating func read(_ tag: Tag) -> Data? {
+        guard let contents = peek(tag) else { return nil }
+
+        position = contents.endIndex
+        return contents
+    }
+
+    private func peek(_ tag: Tag) -> Data? {
+        guard let (elementTag, contentsRange) = element(at: position), elementTag == tag.rawValue else { return nil }
+
+        return data[contentsRange]
+    }
+
+    /// Returns the tag and the contents range of the element starting at `index`, if the element fits in the data.
+    ///
+    /// - Short form length: one byte, bit 8 is 0 and bits 7-1 give the length.
+    /// - Long form length: bit 8 of the first byte is 1 and bits 7-1 give the number of following bytes,
+    ///   which give the length, most significant byte first. Indefinite lengths (0x80) aren't allowed in DER.
+    private func element(at index: Data.Index) -> (tag: UInt8, contents: Range<Data.Index>)? {
+        guard data.endIndex - index >= 2 else { return nil }
+
+        let tag = data[index]
+        // high tag numbers, continued in the following bytes, aren't used by the Firefox key databases
+        guard tag & 0x1F != 0x1F else { return nil }
+
+        let firstLengthByte = data[index + 1]
+        var contentsStart = index + 2
+        var length = Int(firstLengthByte)
+
+        if firstLengthByte >= 0x80 {
+            let lengthByteCount = Int(firstLengthByte & 0x7F)
+            guard (1...4).contains(lengthByteCount), data.endIndex - contentsStart >= lengthByteCount else { return nil }
+
+            length = data[contentsStart ..< contentsStart + lengthByteCount].reduce(0) { $0 << 8 | Int($1) }
+            contentsStart += lengthByteCount
+        }
+
+        guard length <= data.endIndex - contentsStart else { return nil }
+
+        return (tag, contentsStart ..< contentsStart + length)
+    }
+
+}
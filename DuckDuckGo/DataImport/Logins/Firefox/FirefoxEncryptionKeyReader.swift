@@ -85,23 +85,19 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
 
         // Part 1: Take the data from the database and decrypt it.
 
-        let decodedASNData = try ASN1Parser.parse(data: asnData)
-        let entrySalt = try extractKey3EntrySalt(from: decodedASNData)
-        let ciphertext = try extractCiphertext(from: decodedASNData)
+        let encryptedData = try readTripleDesEncryptedData(from: asnData)
 
-        let decryptedData = try tripleDesDecrypt(ciphertext: ciphertext,
+        let decryptedData = try tripleDesDecrypt(ciphertext: encryptedData.ciphertext,
                                                  globalSalt: globalSalt,
-                                                 entrySalt: entrySalt,
+                                                 entrySalt: encryptedData.entrySalt,
                                                  primaryPassword: primaryPassword)
 
         // Part 2: Take the decrypted ASN1 data, parse it, and extract the key.
         operationType = .key3readerStage2
-        let decryptedASNData = try ASN1Parser.parse(data: decryptedData)
-        let extractedASNData = try extractKey3DecryptedASNData(from: decryptedASNData)
+        let extractedASNData = try extractKey3DecryptedASNData(from: decryptedData)
 
         operationType = .key3readerStage3
-        let keyContainerASNData = try ASN1Parser.parse(data: extractedASNData)
-        let key = try extractKey3Key(from: keyContainerASNData)
+        let key = try extractKey3Key(from: extractedASNData)
 
         return key
     }
@@ -126,10 +122,8 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
         return try queue.read { database in
             guard let metadataRow = try MetadataRow.fetchOne(database, sql: "SELECT item1, item2 FROM metadata WHERE id = 'password'") else { throw KeyReaderFileLineError() }
 
-            let decodedASNData = try ASN1Parser.parse(data: metadataRow.item2)
-
             operationType = .key4readerStage2
-            if let tripleDesData = try extractKeyUsing3DES(from: decodedASNData,
+            if let tripleDesData = try extractKeyUsing3DES(from: metadataRow.item2,
                                                            globalSalt: metadataRow.globalSalt,
                                                            primaryPassword: primaryPassword,
                                                            database: database) {
@@ -138,7 +132,7 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
             }
 
             operationType = .key4readerStage3
-            return try extractKeyUsingAES(from: decodedASNData,
+            return try extractKeyUsingAES(from: metadataRow.item2,
                                           globalSalt: metadataRow.globalSalt,
                                           primaryPassword: primaryPassword,
                                           database: database)
@@ -157,37 +151,44 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
 
     // MARK: - Key3 Database Parsing
 
-    private func extractKey3EntrySalt(from tlv: ASN1Parser.Node) throws -> Data {
+    /// Reads the PBE-SHA1-3DES encrypted data:
+    /// `SEQUENCE { SEQUENCE { OID, SEQUENCE { entrySalt OCTET STRING, iterations INTEGER } }, ciphertext OCTET STRING }`
+    private func readTripleDesEncryptedData(from data: Data) throws -> TripleDesEncryptedData {
+        var reader = ASN1DERReader(data: data)
         var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(outerSequence) = tlv, lineError.next(),
-              let firstSequence = outerSequence[safe: 0], lineError.next(),
-              case let .sequence(secondSequence) = firstSequence, lineError.next(),
-              let penultimateSequence = secondSequence[safe: 1], lineError.next(),
-              case let .sequence(finalSequence) = penultimateSequence, lineError.next(),
-              let octetString = finalSequence[safe: 0], lineError.next(),
-              case let .octetString(data: data) = octetString else {
+        guard var encryptedData = reader.readSequence(), lineError.next(),
+              var algorithm = encryptedData.readSequence(), lineError.next(),
+              algorithm.skipElement(), lineError.next(),
+              var parameters = algorithm.readSequence(), lineError.next(),
+              let entrySalt = parameters.readOctetString(), lineError.next(),
+              let ciphertext = encryptedData.readOctetString() else {
             throw lineError
         }
 
-        return data
+        return TripleDesEncryptedData(entrySalt: entrySalt, ciphertext: ciphertext)
     }
 
-    private func extractKey3DecryptedASNData(from node: ASN1Parser.Node) throws -> Data {
+    /// Reads the private key of the decrypted PKCS #8 private key info:
+    /// `SEQUENCE { version INTEGER, SEQUENCE { OID, NULL }, privateKey OCTET STRING }`
+    private func extractKey3DecryptedASNData(from data: Data) throws -> Data {
+        var reader = ASN1DERReader(data: data)
         var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(outerSequence) = node, lineError.next(),
-              let octetString = outerSequence[safe: 2], lineError.next(),
-              case let .octetString(data: data) = octetString else {
+        guard var privateKeyInfo = reader.readSequence(), lineError.next(),
+              privateKeyInfo.skipElement(), privateKeyInfo.skipElement(), lineError.next(),
+              let privateKey = privateKeyInfo.readOctetString() else {
             throw lineError
         }
 
-        return data
+        return privateKey
     }
 
-    private func extractKey3Key(from node: ASN1Parser.Node) throws -> Data {
+    /// Reads the key from the fourth integer of the private key.
+    private func extractKey3Key(from data: Data) throws -> Data {
+        var reader = ASN1DERReader(data: data)
         var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(outerSequence) = node, lineError.next(),
-              let integer = outerSequence[safe: 3], lineError.next(),
-              case let .integer(data: data) = integer, lineError.next(),
+        guard var privateKey = reader.readSequence(), lineError.next(),
+              privateKey.skipElement(), privateKey.skipElement(), privateKey.skipElement(), lineError.next(),
+              let data = privateKey.readIntegerBytes(), lineError.next(),
               data.count >= Constants.key3length else {
             throw lineError
         }
@@ -232,98 +233,50 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
 
     // MARK: - Key4 Database Parsing
 
-    private func extractKey4EntrySalt(from tlv: ASN1Parser.Node) throws -> Data {
-        var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(values1) = tlv, lineError.next(),
-              let firstValue = values1[safe: 0], lineError.next(),
-              case let .sequence(values2) = firstValue, lineError.next(),
-              let secondValue = values2[safe: 1], lineError.next(),
-              case let .sequence(values3) = secondValue, lineError.next(),
-              let thirdValue = values3[safe: 0], lineError.next(),
-              case let .sequence(values4) = thirdValue, lineError.next(),
-              let fourthValue = values4[safe: 1], lineError.next(),
-              case let .sequence(values5) = fourthValue, lineError.next(),
-              let fifthValue = values5[safe: 0], lineError.next(),
-              case let .octetString(data: data) = fifthValue else {
-            throw lineError
-        }
-
-        return data
-    }
-
-    private func extractIterationCount(from tlv: ASN1Parser.Node) throws -> Int {
-        var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(values1) = tlv, lineError.next(),
-              let firstValue = values1[safe: 0], lineError.next(),
-              case let .sequence(values2) = firstValue, lineError.next(),
-              let secondValue = values2[safe: 1], lineError.next(),
-              case let .sequence(values3) = secondValue, lineError.next(),
-              let thirdValue = values3[safe: 0], lineError.next(),
-              case let .sequence(values4) = thirdValue, lineError.next(),
-              let fourthValue = values4[safe: 1], lineError.next(),
-              case let .sequence(values5) = fourthValue, lineError.next(),
-              let fifthValue = values5[safe: 1], lineError.next(),
-              case let .integer(data: data) = fifthValue else {
-            throw lineError
-        }
-
-        return data.integer
-    }
-
-    private func extractKeyLength(from tlv: ASN1Parser.Node) throws -> Int {
-        var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(values1) = tlv, lineError.next(),
-              let firstValue = values1[safe: 0], lineError.next(),
-              case let .sequence(values2) = firstValue, lineError.next(),
-              let secondValue = values2[safe: 1], lineError.next(),
-              case let .sequence(values3) = secondValue, lineError.next(),
-              let thirdValue = values3[safe: 0], lineError.next(),
-              case let .sequence(values4) = thirdValue, lineError.next(),
-              let fourthValue = values4[safe: 1], lineError.next(),
-              case let .sequence(values5) = fourthValue, lineError.next(),
-              let fifthValue = values5[safe: 2], lineError.next(),
-              case let .integer(data: data) = fifthValue else {
-            throw lineError
-        }
-
-        return data.integer
-    }
-
-    private func extractInitializationVector(from tlv: ASN1Parser.Node) throws -> Data {
+    /// Reads the PBES2 encrypted data and its parameters in one pass:
+    /// ```
+    /// SEQUENCE {
+    ///   SEQUENCE {
+    ///     OID pkcs5PBES2
+    ///     SEQUENCE {
+    ///       SEQUENCE { OID pkcs5PBKDF2, SEQUENCE { entrySalt OCTET STRING, iterationCount INTEGER, keyLength INTEGER, ... } }
+    ///       SEQUENCE { OID aes256-CBC, iv OCTET STRING }
+    ///     }
+    ///   }
+    ///   ciphertext OCTET STRING
+    /// }
+    /// ```
+    private func readAESEncryptedData(from data: Data) throws -> AESEncryptedData {
+        var reader = ASN1DERReader(data: data)
         var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(values1) = tlv, lineError.next(),
-              let firstValue = values1[safe: 0], lineError.next(),
-              case let .sequence(values2) = firstValue, lineError.next(),
-              let secondValue = values2[safe: 1], lineError.next(),
-              case let .sequence(values3) = secondValue, lineError.next(),
-              let thirdValue = values3[safe: 1], lineError.next(),
-              case let .sequence(values4) = thirdValue, lineError.next(),
-              let fourthValue = values4[safe: 1], lineError.next(),
-              case let .octetString(data: data) = fourthValue else {
+        guard var encryptedData = reader.readSequence(), lineError.next(),
+              var algorithm = encryptedData.readSequence(), lineError.next(),
+              algorithm.skipElement(), lineError.next(),
+              var pbes2Parameters = algorithm.readSequence(), lineError.next(),
+              var keyDerivationFunction = pbes2Parameters.readSequence(), lineError.next(),
+              keyDerivationFunction.skipElement(), lineError.next(),
+              var pbkdf2Parameters = keyDerivationFunction.readSequence(), lineError.next(),
+              let entrySalt = pbkdf2Parameters.readOctetString(), lineError.next(),
+              let iterationCount = pbkdf2Parameters.readInteger(), lineError.next(),
+              let keyLength = pbkdf2Parameters.readInteger(), lineError.next(),
+              var encryptionScheme = pbes2Parameters.readSequence(), lineError.next(),
+              encryptionScheme.skipElement(), lineError.next(),
+              let initializationVector = encryptionScheme.readOctetString(), lineError.next(),
+              let ciphertext = encryptedData.readOctetString() else {
             throw lineError
         }
 
-        return data
+        return AESEncryptedData(entrySalt: entrySalt,
+                                iterationCount: iterationCount,
+                                keyLength: keyLength,
+                                initializationVector: initializationVector,
+                                ciphertext: ciphertext)
     }
 
-    private func extractCiphertext(from tlv: ASN1Parser.Node) throws -> Data {
-        var lineError = KeyReaderFileLineError.nextLine()
-        guard case let .sequence(values) = tlv, lineError.next(),
-              case let .octetString(data: data) = values[safe: 1] else {
-            throw lineError
-        }
-
-        return data
-    }
-
-    private func aesDecrypt(tlv: ASN1Parser.Node,
-                            iv: Data,
+    private func aesDecrypt(encryptedData: AESEncryptedData,
                             globalSalt: Data,
                             primaryPassword: String) throws -> Data {
-        let data = try extractCiphertext(from: tlv)
-        let entrySalt = try extractKey4EntrySalt(from: tlv)
-        let iterationCount = try extractIterationCount(from: tlv)
-        let keyLength = try extractKeyLength(from: tlv)
+        let keyLength = encryptedData.keyLength
         let primaryPasswordData = primaryPassword.utf8data
 
         assert(keyLength == 32)
@@ -332,27 +285,26 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
         let hashData = SHA.from(data: passwordData)
 
         let commonCryptoKey = try Cryptography.decryptPBKDF2(password: .base64(hashData.base64EncodedString()),
-                                                             salt: entrySalt,
+                                                             salt: encryptedData.entrySalt,
                                                              keyByteCount: keyLength,
-                                                             rounds: iterationCount,
+                                                             rounds: encryptedData.iterationCount,
                                                              kdf: .sha256)
 
-        let iv = Data([4, 14]) + iv
-        let decryptedData = try Cryptography.decryptAESCBC(data: data, key: commonCryptoKey.dataRepresentation, iv: iv)
+        let iv = Data([4, 14]) + encryptedData.initializationVector
+        let decryptedData = try Cryptography.decryptAESCBC(data: encryptedData.ciphertext, key: commonCryptoKey.dataRepresentation, iv: iv)
 
         return decryptedData
     }
 
     // MARK: - ASN Key Extraction
 
-    private func extractKeyUsing3DES(from node: ASN1Parser.Node, globalSalt: Data, primaryPassword: String, database: GRDB.Database) throws -> Data? {
+    private func extractKeyUsing3DES(from passwordCheckData: Data, globalSalt: Data, primaryPassword: String, database: GRDB.Database) throws -> Data? {
         guard let decryptedCiphertext: Data = {
-            guard let entrySalt = try? extractKey3EntrySalt(from: node),
-                  let passwordCheckCiphertext = try? extractCiphertext(from: node) else { return nil }
+            guard let passwordCheck = try? readTripleDesEncryptedData(from: passwordCheckData) else { return nil }
 
-            return try? tripleDesDecrypt(ciphertext: passwordCheckCiphertext,
+            return try? tripleDesDecrypt(ciphertext: passwordCheck.ciphertext,
                                          globalSalt: globalSalt,
-                                         entrySalt: entrySalt,
+                                         entrySalt: passwordCheck.entrySalt,
                                          primaryPassword: primaryPassword)
         }() else { return nil }
 
@@ -364,17 +316,15 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
 
         assert(nssPrivateRow.a102 == Data([248, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1]))
 
-        let decodedA11 = try ASN1Parser.parse(data: nssPrivateRow.a11)
-        let entrySalt = try extractKey3EntrySalt(from: decodedA11)
-        let ciphertext = try extractCiphertext(from: decodedA11)
+        let encryptedKey = try readTripleDesEncryptedData(from: nssPrivateRow.a11)
 
-        let data = try tripleDesDecrypt(ciphertext: ciphertext, globalSalt: globalSalt, entrySalt: entrySalt, primaryPassword: primaryPassword)
+        let data = try tripleDesDecrypt(ciphertext: encryptedKey.ciphertext, globalSalt: globalSalt, entrySalt: encryptedKey.entrySalt, primaryPassword: primaryPassword)
         return data
     }
 
-    private func extractKeyUsingAES(from node: ASN1Parser.Node, globalSalt: Data, primaryPassword: String, database: GRDB.Database) throws -> Data {
-        let iv = try extractInitializationVector(from: node)
-        let decryptedItem2 = try aesDecrypt(tlv: node, iv: iv, globalSalt: globalSalt, primaryPassword: primaryPassword)
+    private func extractKeyUsingAES(from passwordCheckData: Data, globalSalt: Data, primaryPassword: String, database: GRDB.Database) throws -> Data {
+        let passwordCheck = try readAESEncryptedData(from: passwordCheckData)
+        let decryptedItem2 = try aesDecrypt(encryptedData: passwordCheck, globalSalt: globalSalt, primaryPassword: primaryPassword)
 
         let passwordCheckString = String(data: decryptedItem2, encoding: .utf8)
 
@@ -385,10 +335,22 @@ final class FirefoxEncryptionKeyReader: FirefoxEncryptionKeyReading {
 
         assert(nssPrivateRow.a102 == Data([248, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1]))
 
-        let decodedA11 = try ASN1Parser.parse(data: nssPrivateRow.a11)
-        let finalIV = try extractInitializationVector(from: decodedA11)
+        let encryptedKey = try readAESEncryptedData(from: nssPrivateRow.a11)
+
+        return try aesDecrypt(encryptedData: encryptedKey, globalSalt: globalSalt, primaryPassword: primaryPassword)
+    }
+
+    private struct TripleDesEncryptedData {
+        let entrySalt: Data
+        let ciphertext: Data
+    }
 
-        return try aesDecrypt(tlv: decodedA11, iv: finalIV, globalSalt: globalSalt, primaryPassword: primaryPassword)
+    private struct AESEncryptedData {
+        let entrySalt: Data
+        let iterationCount: Int
+        let keyLength: Int
+        let initializationVector: Data
+        let ciphertext: Data
     }
 
     fileprivate struct NssPrivateRow: FetchableRecord {
@@ -162,36 +162,54 @@ final class FirefoxLoginReader {
         // Filter out rows that are used by the Firefox sync service.
         let loginsToImport = logins.logins.filter { $0.hostname != "chrome://FirefoxAccounts" }
 
-        var lastError: Error?
-        for login in loginsToImport {
+        // the key is derived once, logins are decrypted on all cores
+        let decryptionResults = loginsToImport.concurrentMap { login -> Result<ImportedLoginCredential, DecryptionError> in
+            var operationType = ImportError.OperationType.decryptUsername
             do {
-                currentOperationType = .decryptUsername
                 let decryptedUsername = try decrypt(credential: login.encryptedUsername, key: key)
-                currentOperationType = .decryptPassword
+                operationType = .decryptPassword
                 let decryptedPassword = try decrypt(credential: login.encryptedPassword, key: key)
 
-                credentials.append(ImportedLoginCredential(url: login.hostname, username: decryptedUsername, password: decryptedPassword, notes: nil))
+                return .success(ImportedLoginCredential(url: login.hostname, username: decryptedUsername, password: decryptedPassword, notes: nil))
             } catch {
+                return .failure(DecryptionError(operationType: operationType, underlyingError: error))
+            }
+        }
+
+        var lastError: DecryptionError?
+        for decryptionResult in decryptionResults {
+            switch decryptionResult {
+            case .success(let credential):
+                credentials.append(credential)
+            case .failure(let error):
                 lastError = error
             }
         }
 
         if let lastError, credentials.isEmpty {
-            throw lastError
+            currentOperationType = lastError.operationType
+            throw lastError.underlyingError
         }
         return credentials
     }
 
+    private struct DecryptionError: Error {
+        let operationType: ImportError.OperationType
+        let underlyingError: Error
+    }
+
     private func decrypt(credential: String, key: Data) throws -> String {
         guard let base64Decoded = Data(base64Encoded: credential) else { throw LoginReaderFileLineError() }
 
-        let asn1Decoded = try ASN1Parser.parse(data: base64Decoded)
-
+        // SEQUENCE { keyId OCTET STRING, SEQUENCE { OID, iv OCTET STRING }, ciphertext OCTET STRING }
+        var reader = ASN1DERReader(data: base64Decoded)
         var lineError = LoginReaderFileLineError.nextLine()
-        guard case let .sequence(topLevelValues) = asn1Decoded, lineError.next(),
-              case let .sequence(initializationVectorValues) = topLevelValues[1], lineError.next(),
-              case let .octetString(initializationVector) = initializationVectorValues[1], lineError.next(),
-              case let .octetString(ciphertext) = topLevelValues[2] else {
+        guard var encryptedCredential = reader.readSequence(), lineError.next(),
+              encryptedCredential.skipElement(), lineError.next(),
+              var algorithm = encryptedCredential.readSequence(), lineError.next(),
+              algorithm.skipElement(), lineError.next(),
+              let initializationVector = algorithm.readOctetString(), lineError.next(),
+              let ciphertext = encryptedCredential.readOctetString() else {
             throw lineError
         }
 
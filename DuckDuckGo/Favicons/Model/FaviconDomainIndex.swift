@@ -0,0 +1,88 @@
+//
+//  FaviconDomainIndex.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Index of favicon cache entry keys by the host of their document and all its parent domains.
+///
+/// Burning a domain or looking up a subdomain visits only the entries under the domain instead of filtering the whole cache.
+/// An entry is registered under its host and every parent domain except the top-level one, so `example.com` posts
+/// the entries of `example.com`, `www.example.com`, `a.b.example.com` etc.
+struct FaviconDomainIndex<Key: Hashable> {
+
+    private(set) var keysByHost = [String: Set<Key>]()
+    private var keysByDomain = [String: Set<Key>]()
+
+    var hosts: Dictionary<String, Set<Key>>.Keys {
+        keysByHost.keys
+    }
+
+    var isEmpty: Bool {
+        keysByHost.isEmpty
+    }
+
+    mutating func insert(_ key: Key, host: String) {
+        keysByHost[host, default: []].insert(key)
+        for domain in Self.domains(of: host) {
+            keysByDomain[domain, default: []].insert(key)
+        }
+    }
+
+    mutating func remove(_ key: Key, host: String) {
+        Self.remove(key, for: host, from: &keysByHost)
+        for domain in Self.domains(of: host) {
+            Self.remove(key, for: domain, from: &keysByDomain)
+        }
+    }
+
+    mutating func removeAll() {
+        keysByHost.removeAll()
+        keysByDomain.removeAll()
+    }
+
+    /// Keys of the entries with the exact `host`.
+    func keys(forHost host: String) -> Set<Key> {
+        keysByHost[host] ?? []
+    }
+
+    /// Keys of the entries with the host equal to `domain` or any of its subdomains.
+    func keys(forDomainOrAnySubdomain domain: String) -> Set<Key> {
+        keysByDomain[domain] ?? []
+    }
+
+    /// `host`, followed by its parent domains down to (but excluding) the top-level domain.
+    static func domains(of host: String) -> [String] {
+        var domains = [host]
+        var domain = host[...]
+        while let dotIndex = domain.firstIndex(of: ".") {
+            domain = domain[domain.index(after: dotIndex)...]
+            guard domain.contains(".") else { break }
+            domains.append(String(domain))
+        }
+        return domains
+    }
+
+    private static func remove(_ key: Key, for domain: String, from dictionary: inout [String: Set<Key>]) {
+        guard var keys = dictionary.removeValue(forKey: domain) else { return }
+        keys.remove(key)
+        if !keys.isEmpty {
+            dictionary[domain] = keys
+        }
+    }
+
+}
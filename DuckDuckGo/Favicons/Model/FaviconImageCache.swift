@@ -28,6 +28,8 @@ final class FaviconImageCache {
     private let storing: FaviconStoring
 
     private var entries = [URL: Favicon]()
+    // Favicon URLs by the document host and its parent domains
+    private var domainIndex = FaviconDomainIndex<URL>()
 
     init(faviconStoring: FaviconStoring) {
         storing = faviconStoring
@@ -57,7 +59,7 @@ final class FaviconImageCache {
         }
 
         for favicon in favicons {
-            entries[favicon.url] = favicon
+            setEntry(favicon)
         }
         loaded = true
     }
@@ -70,7 +72,7 @@ final class FaviconImageCache {
 
         // Save the new ones
         for favicon in favicons {
-            entries[favicon.url] = favicon
+            setEntry(favicon)
         }
 
         Task {
@@ -106,13 +108,11 @@ final class FaviconImageCache {
                                     completion: @escaping @MainActor () -> Void) {
         let bookmarkedHosts = bookmarkManager.allHosts()
         Task {
-            await self.removeFavicons(filter: { favicon in
-                guard let host = favicon.documentUrl.host else {
-                    return false
-                }
-                return favicon.dateCreated < Date.monthAgo &&
+            await self.removeFavicons(filter: { host in
                 !fireproofDomains.isFireproof(fireproofDomain: host) &&
                 !bookmarkedHosts.contains(host)
+            }, where: { favicon in
+                favicon.dateCreated < Date.monthAgo
             })
             await completion()
         }
@@ -126,13 +126,10 @@ final class FaviconImageCache {
                                 completion: @escaping @MainActor () -> Void) {
         let bookmarkedHosts = bookmarkManager.allHosts()
         Task {
-            await self.removeFavicons(filter: { favicon in
-                guard let host = favicon.documentUrl.host else {
-                    return false
-                }
-                return !(fireproofDomains.isFireproof(fireproofDomain: host) ||
-                         bookmarkedHosts.contains(host) ||
-                         savedLogins.contains(host)
+            await self.removeFavicons(filter: { host in
+                !(fireproofDomains.isFireproof(fireproofDomain: host) ||
+                  bookmarkedHosts.contains(host) ||
+                  savedLogins.contains(host)
                 )
             })
             await completion()
@@ -147,9 +144,8 @@ final class FaviconImageCache {
                                  completion: @escaping @MainActor () -> Void) {
         let bookmarkedHosts = bookmarkManager.allHosts()
         Task {
-            await self.removeFavicons(filter: { favicon in
-                guard let host = favicon.documentUrl.host, let baseDomain = tld.eTLDplus1(host) else { return false }
-                return baseDomains.contains(baseDomain)
+            await self.removeFavicons(underDomains: baseDomains, filter: { host, baseDomain in
+                tld.eTLDplus1(host) == baseDomain
                     && !bookmarkedHosts.contains(host)
                     && !logins.contains(host)
                     && !history.contains(host)
@@ -160,9 +156,45 @@ final class FaviconImageCache {
 
     // MARK: - Private
 
-    private func removeFavicons(filter isRemoved: (Favicon) -> Bool) async {
-        let faviconsToRemove = entries.values.filter(isRemoved)
-        faviconsToRemove.forEach { entries[$0.url] = nil }
+    private func setEntry(_ favicon: Favicon) {
+        if let oldHost = entries[favicon.url]?.documentUrl.host {
+            domainIndex.remove(favicon.url, host: oldHost)
+        }
+        entries[favicon.url] = favicon
+        if let host = favicon.documentUrl.host {
+            domainIndex.insert(favicon.url, host: host)
+        }
+    }
+
+    /// Removes the favicons of the document hosts matching `isHostRemoved` (evaluated once per host).
+    /// Favicons without a document host are never removed.
+    private func removeFavicons(filter isHostRemoved: (String) -> Bool, where isRemoved: (Favicon) -> Bool = { _ in true }) async {
+        let faviconUrls = domainIndex.hosts.filter(isHostRemoved).flatMap { domainIndex.keys(forHost: $0) }
+        await removeFavicons(withUrls: faviconUrls, where: isRemoved)
+    }
+
+    /// Removes the favicons of the document hosts under `domains` matching `isHostRemoved`, visiting only the favicons under the domains.
+    private func removeFavicons(underDomains domains: Set<String>, filter isHostRemoved: (_ host: String, _ domain: String) -> Bool) async {
+        var faviconUrls = [URL]()
+        for domain in domains {
+            for faviconUrl in domainIndex.keys(forDomainOrAnySubdomain: domain) {
+                guard let host = entries[faviconUrl]?.documentUrl.host, isHostRemoved(host, domain) else { continue }
+                faviconUrls.append(faviconUrl)
+            }
+        }
+        await removeFavicons(withUrls: faviconUrls)
+    }
+
+    private func removeFavicons(withUrls faviconUrls: [URL], where isRemoved: (Favicon) -> Bool = { _ in true }) async {
+        var faviconsToRemove = [Favicon]()
+        for faviconUrl in faviconUrls {
+            guard let favicon = entries[faviconUrl], isRemoved(favicon) else { continue }
+            entries[faviconUrl] = nil
+            if let host = favicon.documentUrl.host {
+                domainIndex.remove(faviconUrl, host: host)
+            }
+            faviconsToRemove.append(favicon)
+        }
 
         await removeFaviconsFromStore(faviconsToRemove)
     }
@@ -222,12 +222,7 @@ final class FaviconManager: FaviconManagement {
             return favicon
         }
 
-        let availableSubdomains = referenceCache.hostReferences.keys + referenceCache.urlReferences.keys.compactMap { $0.host }
-        let subdomain = availableSubdomains.first { subdomain in
-            subdomain.hasSuffix(domain)
-        }
-
-        if let subdomain {
+        if let subdomain = referenceCache.host(forDomainOrAnySubdomain: domain) {
             return getCachedFavicon(for: subdomain, sizeCategory: sizeCategory)
         }
         return nil
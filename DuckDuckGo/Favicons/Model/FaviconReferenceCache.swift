@@ -33,6 +33,10 @@ final class FaviconReferenceCache {
     // References to favicon URLs for special URLs
     private(set) var urlReferences = [URL: FaviconUrlReference]()
 
+    // Reference keys by host and its parent domains
+    private var hostReferencesIndex = FaviconDomainIndex<String>()
+    private var urlReferencesIndex = FaviconDomainIndex<URL>()
+
     init(faviconStoring: FaviconStoring) {
         storing = faviconStoring
     }
@@ -56,10 +60,10 @@ final class FaviconReferenceCache {
 
             await Task { @MainActor in
                 for reference in hostReferences {
-                    self.hostReferences[reference.host] = reference
+                    self.setHostReference(reference)
                 }
                 for reference in urlReferences {
-                    self.urlReferences[reference.documentUrl] = reference
+                    self.setUrlReference(reference)
                 }
                 loaded = true
 
@@ -149,6 +153,18 @@ final class FaviconReferenceCache {
         }
     }
 
+    /// Returns a host with a cached favicon reference equal to `domain` or any of its subdomains.
+    func host(forDomainOrAnySubdomain domain: String) -> String? {
+        guard loaded else {
+            return nil
+        }
+
+        if let host = hostReferencesIndex.keys(forDomainOrAnySubdomain: domain).first {
+            return host
+        }
+        return urlReferencesIndex.keys(forDomainOrAnySubdomain: domain).first?.host
+    }
+
     // MARK: - Clean
 
     nonisolated func cleanOldExcept(fireproofDomains: FireproofDomains,
@@ -163,20 +179,17 @@ final class FaviconReferenceCache {
     func cleanOld(except fireproofDomains: FireproofDomains, bookmarkManager: BookmarkManager) async {
         let bookmarkedHosts = bookmarkManager.allHosts()
         // Remove host references
-        await removeHostReferences(filter: { hostReference in
-            let host = hostReference.host
-            return hostReference.dateCreated < Date.monthAgo &&
-                !fireproofDomains.isFireproof(fireproofDomain: host) &&
+        func isHostRemoved(host: String) -> Bool {
+            return !fireproofDomains.isFireproof(fireproofDomain: host) &&
                 !bookmarkedHosts.contains(host)
+        }
+
+        await removeHostReferences(filter: isHostRemoved, where: { hostReference in
+            hostReference.dateCreated < Date.monthAgo
         }).value
         // Remove URL references
-        await removeUrlReferences(filter: { urlReference in
-            guard let host = urlReference.documentUrl.host else {
-                return false
-            }
-            return urlReference.dateCreated < Date.monthAgo &&
-            !fireproofDomains.isFireproof(fireproofDomain: host) &&
-            !bookmarkedHosts.contains(host)
+        await removeUrlReferences(filter: isHostRemoved, where: { urlReference in
+            urlReference.dateCreated < Date.monthAgo
         }).value
     }
 
@@ -201,16 +214,12 @@ final class FaviconReferenceCache {
         }
 
         // Remove host references
-        await removeHostReferences(filter: { hostReference in
-            let host = hostReference.host
-            return !isHostApproved(host: host)
+        await removeHostReferences(filter: { host in
+            !isHostApproved(host: host)
         }).value
         // Remove URL references
-        await removeUrlReferences(filter: { urlReference in
-            guard let host = urlReference.documentUrl.host else {
-                return false
-            }
-            return !isHostApproved(host: host)
+        await removeUrlReferences(filter: { host in
+            !isHostApproved(host: host)
         }).value
     }
 
@@ -233,18 +242,20 @@ final class FaviconReferenceCache {
                      tld: TLD) async {
         // Remove host references
         let bookmarkedHosts = bookmarkManager.allHosts()
-        await removeHostReferences(filter: { hostReference in
-            let host = hostReference.host
-            let baseDomain = tld.eTLDplus1(host) ?? ""
-            return baseDomains.contains(baseDomain) && !bookmarkedHosts.contains(host) && !logins.contains(host) && !history.contains(host)
-        }).value
+        func isHostRemoved(host: String) -> Bool {
+            return !bookmarkedHosts.contains(host) && !logins.contains(host) && !history.contains(host)
+        }
+
+        // Only the references under the burned domains are visited
+        let hosts = baseDomains.flatMap { baseDomain in
+            hostReferencesIndex.keys(forDomainOrAnySubdomain: baseDomain).filter { tld.eTLDplus1($0) == baseDomain }
+        }
+        await removeHostReferences(hosts.filter(isHostRemoved)).value
         // Remove URL references
-        await removeUrlReferences(filter: { urlReference in
-            guard let host = urlReference.documentUrl.host else {
-                return false
-            }
-            return baseDomains.contains(host) && !bookmarkedHosts.contains(host) && !logins.contains(host) && !history.contains(host)
-        }).value
+        let documentUrls = baseDomains.filter(isHostRemoved).flatMap { host in
+            urlReferencesIndex.keys(forHost: host)
+        }
+        await removeUrlReferences(documentUrls).value
     }
 
     // MARK: - Private
@@ -264,7 +275,7 @@ final class FaviconReferenceCache {
                                               host: host,
                                               documentUrl: documentUrl,
                                               dateCreated: Date())
-        hostReferences[host] = hostReference
+        setHostReference(hostReference)
 
         Task {
             do {
@@ -291,7 +302,7 @@ final class FaviconReferenceCache {
                                              documentUrl: documentUrl,
                                              dateCreated: Date())
 
-        urlReferences[documentUrl] = urlReference
+        setUrlReference(urlReference)
 
         Task.detached {
             do {
@@ -304,14 +315,38 @@ final class FaviconReferenceCache {
     }
 
     private func invalidateUrlCache(for host: String) {
-        _=self.removeUrlReferences { urlReference in
-            urlReference.documentUrl.host == host
+        _=self.removeUrlReferences(Array(urlReferencesIndex.keys(forHost: host)))
+    }
+
+    private func setHostReference(_ hostReference: FaviconHostReference) {
+        hostReferences[hostReference.host] = hostReference
+        hostReferencesIndex.insert(hostReference.host, host: hostReference.host)
+    }
+
+    private func setUrlReference(_ urlReference: FaviconUrlReference) {
+        if let oldHost = urlReferences[urlReference.documentUrl]?.documentUrl.host {
+            urlReferencesIndex.remove(urlReference.documentUrl, host: oldHost)
+        }
+        urlReferences[urlReference.documentUrl] = urlReference
+        if let host = urlReference.documentUrl.host {
+            urlReferencesIndex.insert(urlReference.documentUrl, host: host)
         }
     }
 
-    private func removeHostReferences(filter isRemoved: (FaviconHostReference) -> Bool) -> Task<Void, Never> {
-        let hostReferencesToRemove = hostReferences.values.filter(isRemoved)
-        hostReferencesToRemove.forEach { hostReferences[$0.host] = nil }
+    /// Removes the references of the hosts matching `isHostRemoved` (evaluated once per host).
+    private func removeHostReferences(filter isHostRemoved: (String) -> Bool,
+                                      where isRemoved: (FaviconHostReference) -> Bool = { _ in true }) -> Task<Void, Never> {
+        removeHostReferences(hostReferencesIndex.hosts.filter(isHostRemoved), where: isRemoved)
+    }
+
+    private func removeHostReferences(_ hosts: [String], where isRemoved: (FaviconHostReference) -> Bool = { _ in true }) -> Task<Void, Never> {
+        var hostReferencesToRemove = [FaviconHostReference]()
+        for host in hosts {
+            guard let hostReference = hostReferences[host], isRemoved(hostReference) else { continue }
+            hostReferences[host] = nil
+            hostReferencesIndex.remove(host, host: host)
+            hostReferencesToRemove.append(hostReference)
+        }
 
         return Task.detached {
             await self.removeHostReferencesFromStore(hostReferencesToRemove)
@@ -329,9 +364,24 @@ final class FaviconReferenceCache {
         }
     }
 
-    private func removeUrlReferences(filter isRemoved: (FaviconUrlReference) -> Bool) -> Task<Void, Never> {
-        let urlReferencesToRemove = urlReferences.values.filter(isRemoved)
-        urlReferencesToRemove.forEach { urlReferences[$0.documentUrl] = nil }
+    /// Removes the references of the document hosts matching `isHostRemoved` (evaluated once per host).
+    /// References without a document host are never removed.
+    private func removeUrlReferences(filter isHostRemoved: (String) -> Bool,
+                                     where isRemoved: (FaviconUrlReference) -> Bool = { _ in true }) -> Task<Void, Never> {
+        let documentUrls = urlReferencesIndex.hosts.filter(isHostRemoved).flatMap { urlReferencesIndex.keys(forHost: $0) }
+        return removeUrlReferences(documentUrls, where: isRemoved)
+    }
+
+    private func removeUrlReferences(_ documentUrls: [URL], where isRemoved: (FaviconUrlReference) -> Bool = { _ in true }) -> Task<Void, Never> {
+        var urlReferencesToRemove = [FaviconUrlReference]()
+        for documentUrl in documentUrls {
+            guard let urlReference = urlReferences[documentUrl], isRemoved(urlReference) else { continue }
+            urlReferences[documentUrl] = nil
+            if let host = documentUrl.host {
+                urlReferencesIndex.remove(documentUrl, host: host)
+            }
+            urlReferencesToRemove.append(urlReference)
+        }
 
         return Task.detached {
             await self.removeUrlReferencesFromStore(urlReferencesToRemove)
@@ -0,0 +1,170 @@
+//
+//  DownloadProgressAggregator.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Combine
+import Foundation
+
+/// Publishes download progress changes at a fixed rate instead of on every byte count change.
+///
+/// Download progress objects are updated by their writers as the data comes in; the aggregator samples all of them on a
+/// single main-thread tick, delivers coalesced changes to the subscribers and publishes the aggregate byte counts,
+/// throughput and estimated time remaining per group (e.g. per Fire Window session).
+/// The tick timer only runs while there are subscriptions, so idle downloads cause no wakeups.
+@MainActor
+final class DownloadProgressAggregator {
+
+    static let shared = DownloadProgressAggregator()
+
+    struct Aggregate: Equatable {
+        var totalUnitCount: Int64 = 0
+        var completedUnitCount: Int64 = 0
+        /// bytes per second
+        var throughput: Int?
+        var estimatedTimeRemaining: TimeInterval?
+    }
+
+    typealias UpdateHandler = @MainActor (_ totalUnitCount: Int64, _ completedUnitCount: Int64) -> Void
+
+    private enum Constants {
+        static let throughputSmoothingFactor = 0.1
+    }
+
+    private final class Subscription {
+        let progress: Progress
+        let group: AnyHashable?
+        let onUpdate: UpdateHandler
+        var lastTotalUnitCount: Int64 = .min
+        var lastCompletedUnitCount: Int64 = .min
+
+        init(progress: Progress, group: AnyHashable?, onUpdate: @escaping UpdateHandler) {
+            self.progress = progress
+            self.group = group
+            self.onUpdate = onUpdate
+        }
+    }
+
+    private let interval: TimeInterval
+    private var subscriptions = [ObjectIdentifier: Subscription]()
+    private var timer: DispatchSourceTimer?
+    private var lastTickDate: Date?
+
+    @Published private(set) var aggregates = [AnyHashable: Aggregate]()
+
+    /// - Parameter frequency: number of progress updates published per second.
+    init(frequency: Double = 5) {
+        assert(frequency > 0)
+        self.interval = 1 / frequency
+    }
+
+    /// Delivers `progress` byte count changes to `onUpdate` at most once per tick.
+    /// The first tick always delivers the current values.
+    ///
+    /// - Parameter group: key of the aggregate the progress contributes to (`nil` to not contribute to any aggregate).
+    /// - Returns: cancellable removing the subscription.
+    func subscribe(to progress: Progress, group: AnyHashable? = nil, onUpdate: @escaping UpdateHandler) -> AnyCancellable {
+        let subscription = Subscription(progress: progress, group: group, onUpdate: onUpdate)
+        let id = ObjectIdentifier(subscription)
+        subscriptions[id] = subscription
+        startTimerIfNeeded()
+
+        return AnyCancellable { [weak self] in
+            DispatchQueue.main.asyncOrNow {
+                MainActor.assumeIsolated {
+                    self?.removeSubscription(withId: id)
+                }
+            }
+        }
+    }
+
+    func aggregatePublisher(for group: AnyHashable) -> AnyPublisher<Aggregate, Never> {
+        $aggregates.map { $0[group] ?? Aggregate() }.removeDuplicates().eraseToAnyPublisher()
+    }
+
+    private func removeSubscription(withId id: ObjectIdentifier) {
+        guard let subscription = subscriptions.removeValue(forKey: id) else { return }
+
+        if let group = subscription.group, !subscriptions.values.contains(where: { $0.group == group }) {
+            aggregates[group] = nil
+        }
+        if subscriptions.isEmpty {
+            timer?.cancel()
+            timer = nil
+            lastTickDate = nil
+        }
+    }
+
+    private func startTimerIfNeeded() {
+        guard timer == nil else { return }
+
+        let timer = DispatchSource.makeTimerSource(queue: .main)
+        // allow the system to coalesce the wakeups with other timers
+        timer.schedule(deadline: .now(), repeating: interval, leeway: .milliseconds(Int(interval * 100)))
+        timer.setEventHandler { [weak self] in
+            MainActor.assumeIsolated {
+                self?.tick()
+            }
+        }
+        timer.resume()
+        self.timer = timer
+    }
+
+    /// Samples all the subscribed progress objects, notifies the changed ones and updates the aggregates.
+    func tick(now: Date = Date()) {
+        let elapsed = lastTickDate.map { now.timeIntervalSince($0) }
+        lastTickDate = now
+
+        var newAggregates = [AnyHashable: Aggregate]()
+        for subscription in Array(subscriptions.values) {
+            let total = subscription.progress.totalUnitCount
+            let completed = subscription.progress.completedUnitCount
+
+            if total != subscription.lastTotalUnitCount || completed != subscription.lastCompletedUnitCount {
+                subscription.lastTotalUnitCount = total
+                subscription.lastCompletedUnitCount = completed
+                subscription.onUpdate(total, completed)
+            }
+
+            guard let group = subscription.group else { continue }
+            var aggregate = newAggregates[group] ?? Aggregate()
+            aggregate.totalUnitCount += max(0, total)
+            aggregate.completedUnitCount += max(0, completed)
+            newAggregates[group] = aggregate
+        }
+
+        for (group, var aggregate) in newAggregates {
+            let previous = aggregates[group]
+            if let previous, let elapsed, elapsed > 0 {
+                let instantThroughput = Double(max(0, aggregate.completedUnitCount - previous.completedUnitCount)) / elapsed
+                // moving average of the download speed
+                let throughput = previous.throughput.map {
+                    Constants.throughputSmoothingFactor * instantThroughput + (1 - Constants.throughputSmoothingFactor) * Double($0)
+                } ?? instantThroughput
+                aggregate.throughput = Int(throughput)
+                if throughput > 0, aggregate.totalUnitCount > aggregate.completedUnitCount {
+                    aggregate.estimatedTimeRemaining = Double(aggregate.totalUnitCount - aggregate.completedUnitCount) / throughput
+                }
+            }
+            newAggregates[group] = aggregate
+        }
+
+        if newAggregates != aggregates {
+            aggregates = newAggregates
+        }
+    }
+
+}
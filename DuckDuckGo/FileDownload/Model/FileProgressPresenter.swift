@@ -52,12 +52,15 @@ final class FileProgressPresenter {
         swap(&fileProgress.flyToImage, &progress.flyToImage)
         fileProgress.fileIcon = progress.fileIcon
 
-        progress.publisher(for: \.totalUnitCount)
-            .assign(to: \.totalUnitCount, onWeaklyHeld: fileProgress)
-            .store(in: &cancellables)
-        progress.publisher(for: \.completedUnitCount)
-            .assign(to: \.completedUnitCount, onWeaklyHeld: fileProgress)
-            .store(in: &cancellables)
+        // published file progress is mirrored to Finder and Dock: only update it at the aggregator rate
+        DownloadProgressAggregator.shared.subscribe(to: progress) { [weak fileProgress] total, completed in
+            guard let fileProgress else { return }
+            if fileProgress.totalUnitCount != total {
+                fileProgress.totalUnitCount = total
+            }
+            fileProgress.completedUnitCount = completed
+        }
+        .store(in: &cancellables)
 
         self.fileProgress = fileProgress
         fileProgress.publish()
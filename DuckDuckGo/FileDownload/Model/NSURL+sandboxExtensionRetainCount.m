@@ -29,7 +29,7 @@
 /**
  * This method will be automatically called at app launch time to swizzle `startAccessingSecurityScopedResource` and
  * `stopAccessingSecurityScopedResource` methods to accurately reflect the current number of start and stop calls
- * stored in the associated `NSURL.sandboxExtensionRetainCount` value.
+ * in `NSURL.sandboxExtensionRetainCount`, counted per URL instance by `SandboxExtensionRetainCounter`.
  *
  * See SecurityScopedFileURLController.swift
  */
@@ -0,0 +1,128 @@
+//
+//  SandboxExtensionRetainCounter.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import os.log
+
+/// Keeps the number of unbalanced `startAccessingSecurityScopedResource` calls per `NSURL` instance.
+///
+/// Counts live in a lock-striped table keyed by object identity rather than in associated objects, so concurrent
+/// downloads and file presenters only contend when their URLs land in the same stripe.
+/// URLs are referenced weakly: an entry whose URL has been deallocated with a non-zero count is a leaked access.
+/// They are removed from a stripe and passed to the `leakHandler` whenever a URL without an entry is counted in the stripe.
+final class SandboxExtensionRetainCounter {
+
+    static let shared = SandboxExtensionRetainCounter()
+
+    struct LeakedAccess: Equatable {
+        let path: String
+        let retainCount: Int
+    }
+
+    typealias LeakHandler = (LeakedAccess) -> Void
+
+    private struct Entry {
+        weak var url: NSURL?
+        let path: String
+        var retainCount: Int
+    }
+
+    private final class Stripe {
+        let lock = NSLock()
+        var entries = [ObjectIdentifier: Entry]()
+
+        /// Removes the entries whose URL has been deallocated, returning the ones with a non-zero count.
+        func removeDeallocatedEntries() -> [LeakedAccess] {
+            var leakedAccesses = [LeakedAccess]()
+            for (key, entry) in entries where entry.url == nil {
+                if entry.retainCount > 0 {
+                    leakedAccesses.append(LeakedAccess(path: entry.path, retainCount: entry.retainCount))
+                }
+                entries[key] = nil
+            }
+            return leakedAccesses
+        }
+    }
+
+    private let stripes: [Stripe]
+    private let leakHandler: LeakHandler
+
+    init(stripeCount: Int = 16, leakHandler: @escaping LeakHandler = { leakedAccess in
+        Logger.sandboxExtensions.error("Leaked sandbox extension (\(leakedAccess.retainCount)) for \"\(leakedAccess.path)\"")
+    }) {
+        assert(stripeCount > 0)
+        stripes = (0..<stripeCount).map { _ in Stripe() }
+        self.leakHandler = leakHandler
+    }
+
+    private func stripe(for url: NSURL) -> Stripe {
+        // drop the low bits which are always zero due to object alignment
+        let address = UInt(bitPattern: Unmanaged.passUnretained(url).toOpaque()) >> 4
+        return stripes[Int(address % UInt(stripes.count))]
+    }
+
+    /// The number of unbalanced start accesses for the `url` instance.
+    func retainCount(for url: NSURL) -> Int {
+        let stripe = stripe(for: url)
+        return stripe.lock.withLock {
+            guard let entry = stripe.entries[ObjectIdentifier(url)], entry.url === url else { return 0 }
+            return entry.retainCount
+        }
+    }
+
+    /// Adds `delta` to the `url` retain count, never going below zero.
+    /// - Returns: the updated retain count.
+    @discardableResult
+    func add(_ delta: Int, to url: NSURL) -> Int {
+        let stripe = stripe(for: url)
+        let key = ObjectIdentifier(url)
+        var leakedAccesses = [LeakedAccess]()
+
+        let retainCount = stripe.lock.withLock {
+            var entry: Entry
+            if let existing = stripe.entries[key], existing.url === url {
+                entry = existing
+            } else {
+                // also drops a stale entry for the identifier, which is reused once the previous object is deallocated
+                leakedAccesses = stripe.removeDeallocatedEntries()
+                guard delta > 0 else { return 0 }
+                entry = Entry(url: url, path: url.path ?? url.absoluteString ?? "", retainCount: 0)
+            }
+
+            entry.retainCount = max(0, entry.retainCount + delta)
+            stripe.entries[key] = entry.retainCount > 0 ? entry : nil
+
+            return entry.retainCount
+        }
+
+        // reported outside of the lock as the handler may start or stop accessing other URLs
+        leakedAccesses.forEach(leakHandler)
+
+        return retainCount
+    }
+
+    /// URL instances currently having a non-zero retain count.
+    func activeURLs() -> [NSURL] {
+        stripes.flatMap { stripe in
+            stripe.lock.withLock {
+                stripe.entries.values.compactMap { $0.retainCount > 0 ? $0.url : nil }
+            }
+        }
+    }
+
+}
@@ -29,7 +29,7 @@ import BrowserServicesKit
 ///
 /// - Note: Used in conjunction with NSURL extension swizzling the `startAccessingSecurityScopedResource` and
 ///         `stopAccessingSecurityScopedResource` methods to accurately reflect the current number of start and stop calls.
-///         The number is reflected in the associated `URL.sandboxExtensionRetainCount` value.
+///         The number is reflected in the `URL.sandboxExtensionRetainCount` value kept by `SandboxExtensionRetainCounter`.
 final class SecurityScopedFileURLController {
     private(set) var url: URL
     let isManagingSecurityScope: Bool
@@ -110,7 +110,7 @@ extension NSURL {
 
     @objc private dynamic func swizzled_startAccessingSecurityScopedResource() -> Bool {
         if self.swizzled_startAccessingSecurityScopedResource() /* call original */ {
-            sandboxExtensionRetainCount += 1
+            SandboxExtensionRetainCounter.shared.add(1, to: self)
             return true
         }
         return false
@@ -119,43 +119,12 @@ extension NSURL {
     @objc private dynamic func swizzled_stopAccessingSecurityScopedResource() {
         self.swizzled_stopAccessingSecurityScopedResource() // call original
 
-        var sandboxExtensionRetainCount = self.sandboxExtensionRetainCount
-        if sandboxExtensionRetainCount > 0 {
-            sandboxExtensionRetainCount -= 1
-            self.sandboxExtensionRetainCount = sandboxExtensionRetainCount
-        }
+        SandboxExtensionRetainCounter.shared.add(-1, to: self)
     }
 
-    private static let sandboxExtensionRetainCountKey = UnsafeRawPointer(bitPattern: "sandboxExtensionRetainCountKey".hashValue)!
-    fileprivate(set) var sandboxExtensionRetainCount: Int {
-        get {
-            (objc_getAssociatedObject(self, Self.sandboxExtensionRetainCountKey) as? NSNumber)?.intValue ?? 0
-        }
-        set {
-            objc_setAssociatedObject(self, Self.sandboxExtensionRetainCountKey, NSNumber(value: newValue), .OBJC_ASSOCIATION_RETAIN)
-#if DEBUG
-            if newValue > 0 {
-                NSURL.activeSecurityScopedUrlUsages.insert(.init(url: self))
-            } else {
-                NSURL.activeSecurityScopedUrlUsages.remove(.init(url: self))
-            }
-#endif
-        }
-    }
-
-#if DEBUG
-    struct SecurityScopedUrlUsage: Hashable {
-        let url: NSURL
-        // hash url as object address
-        func hash(into hasher: inout Hasher) {
-            hasher.combine(ObjectIdentifier(url))
-        }
-        static func == (lhs: Self, rhs: Self) -> Bool {
-            lhs.url === rhs.url
-        }
+    var sandboxExtensionRetainCount: Int {
+        SandboxExtensionRetainCounter.shared.retainCount(for: self)
     }
-    static var activeSecurityScopedUrlUsages: Set<SecurityScopedUrlUsage> = []
-#endif
 
 }
 
@@ -174,7 +143,7 @@ extension URL {
     }
 
     func consumeUnbalancedStartAccessingSecurityScopedResource() {
-        (self as NSURL).sandboxExtensionRetainCount += 1
+        SandboxExtensionRetainCounter.shared.add(1, to: self as NSURL)
     }
 
 }
@@ -67,6 +67,7 @@ final class DownloadListCoordinator {
 
     private let regularWindowDownloadProgress = Progress()
     @MainActor private var fireWindowSessionsProgress = [FireWindowSessionRef: Progress]()
+    @MainActor private var combinedProgressAggregateCancellables = [FireWindowSessionRef?: AnyCancellable]()
 
     init(store: DownloadListStoring = DownloadListStore(),
          downloadManager: FileDownloadManagerProtocol = FileDownloadManager.shared,
@@ -322,13 +323,25 @@ final class DownloadListCoordinator {
 
     @MainActor
     func combinedDownloadProgressCreatingIfNeeded(for fireWindowSession: FireWindowSessionRef?) -> Progress {
-        guard let fireWindowSession else { return regularWindowDownloadProgress }
-
-        return fireWindowSessionsProgress[fireWindowSession] ?? {
-            let progress = Progress()
+        let progress: Progress
+        if let fireWindowSession {
+            progress = fireWindowSessionsProgress[fireWindowSession] ?? Progress()
             fireWindowSessionsProgress[fireWindowSession] = progress
-            return progress
-        }()
+        } else {
+            progress = regularWindowDownloadProgress
+        }
+
+        if combinedProgressAggregateCancellables[fireWindowSession] == nil {
+            // throughput and estimated time for all the session downloads
+            combinedProgressAggregateCancellables[fireWindowSession] = DownloadProgressAggregator.shared
+                .aggregatePublisher(for: AnyHashable(fireWindowSession))
+                .sink { [weak progress] aggregate in
+                    progress?.throughput = aggregate.throughput
+                    progress?.estimatedTimeRemaining = aggregate.estimatedTimeRemaining
+                }
+        }
+
+        return progress
     }
 
     @MainActor
@@ -337,17 +350,14 @@ final class DownloadListCoordinator {
 
         var lastKnownProgress = (total: Int64(0), completed: Int64(0))
         let progress = self.combinedDownloadProgressCreatingIfNeeded(for: task.fireWindowSession)
-        task.progress.publisher(for: \.totalUnitCount)
-            .combineLatest(task.progress.publisher(for: \.completedUnitCount))
-            .throttle(for: 0.2, scheduler: DispatchQueue.main, latest: true)
-            .sink { (total, completed) in
-                guard total > 0, completed > 0 else { return }
-
-                progress.totalUnitCount += (total - lastKnownProgress.total)
-                progress.completedUnitCount += (completed - lastKnownProgress.completed)
-                lastKnownProgress = (total, completed)
-            }
-            .store(in: &self.taskProgressCancellables[task, default: []])
+        DownloadProgressAggregator.shared.subscribe(to: task.progress, group: AnyHashable(task.fireWindowSession)) { total, completed in
+            guard total > 0, completed > 0 else { return }
+
+            progress.totalUnitCount += (total - lastKnownProgress.total)
+            progress.completedUnitCount += (completed - lastKnownProgress.completed)
+            lastKnownProgress = (total, completed)
+        }
+        .store(in: &self.taskProgressCancellables[task, default: []])
 
         task.$state.receive(on: DispatchQueue.main)
             .sink { [weak self] state in
@@ -550,6 +560,7 @@ final class DownloadListCoordinator {
             remove(downloadWithIdentifier: id)
         }
         fireWindowSessionsProgress[fireWindowSession] = nil
+        combinedProgressAggregateCancellables[fireWindowSession] = nil
     }
 
     @MainActor
@@ -51,6 +51,20 @@ final class Fire {
 
     private var dispatchGroup: DispatchGroup?
 
+    /// Burning steps, timed separately to find the slow ones.
+    enum BurnPhase: String {
+        case tabs
+        case webCache
+        case privacyStats
+        case history
+        case permissions
+        case favicons
+    }
+
+    /// Durations of the phases of the last finished burning.
+    private(set) var lastBurnPhaseDurations = [BurnPhase: TimeInterval]()
+    private var burnPhaseDurations = [BurnPhase: TimeInterval]()
+
     enum BurningData: Equatable {
         case specificDomains(_ domains: Set<String>, shouldPlayFireAnimation: Bool)
         case all
@@ -154,26 +168,31 @@ final class Fire {
 
         tabCleanupPreparer.prepareTabsForCleanup(tabViewModels) {
 
-            group.enter()
+            let tabsBurned = self.beginPhase(.tabs, in: group)
             self.burnTabs(burningEntity: entity) {
+                // Website data and history are burned in parallel once the tabs are closed
+                let webCacheBurned = self.beginPhase(.webCache, in: group)
                 Task {
                     await self.burnWebCache(baseDomains: domains)
-                    if includingHistory {
-                        self.burnHistory(ofEntity: entity) {
-                            self.burnFavicons(for: domains) {
-                                group.leave()
-                            }
-                        }
-                    } else {
-                        group.leave()
+                    webCacheBurned()
+                }
+
+                if includingHistory {
+                    let historyBurned = self.beginPhase(.history, in: group)
+                    self.burnHistory(ofEntity: entity) {
+                        // Favicons of the hosts remaining in history are kept
+                        let faviconsBurned = self.beginPhase(.favicons, in: group)
+                        self.burnFavicons(for: domains, completion: faviconsBurned)
+                        historyBurned()
                     }
                 }
+                tabsBurned()
             }
 
-            group.enter()
+            let permissionsBurned = self.beginPhase(.permissions, in: group)
             self.burnPermissions(of: domains, completion: {
                 self.burnDownloads(of: domains)
-                group.leave()
+                permissionsBurned()
             })
 
             self.burnRecentlyClosed(baseDomains: domains)
@@ -185,10 +204,9 @@ final class Fire {
                 self.closeWindows(entity: entity)
 
                 self.burningData = nil
+                self.finishBurnPhases()
 
                 completion?()
-
-                Logger.fire.debug("Fire finished")
             }
         }
     }
@@ -213,21 +231,26 @@ final class Fire {
 
         tabCleanupPreparer.prepareTabsForCleanup(tabViewModels) {
 
-            group.enter()
+            let tabsBurned = self.beginPhase(.tabs, in: group)
             self.burnTabs(burningEntity: .allWindows(mainWindowControllers: windowControllers, selectedDomains: Set())) {
+                // The stores don‘t depend on each other and are burned in parallel once the tabs are closed
+                let webCacheBurned = self.beginPhase(.webCache, in: group)
                 Task { @MainActor in
                     await self.burnWebCache()
+                    webCacheBurned()
+                }
+                let privacyStatsBurned = self.beginPhase(.privacyStats, in: group)
+                Task { @MainActor in
                     await self.burnPrivacyStats()
-                    self.burnAllVisitedLinks()
-                    self.burnAllHistory {
-                        self.burnPermissions {
-                            self.burnFavicons {
-                                self.burnDownloads()
-                                group.leave()
-                            }
-                        }
-                    }
+                    privacyStatsBurned()
                 }
+
+                self.burnAllVisitedLinks()
+                self.burnAllHistory(completion: self.beginPhase(.history, in: group))
+                self.burnPermissions(completion: self.beginPhase(.permissions, in: group))
+                self.burnFavicons(completion: self.beginPhase(.favicons, in: group))
+                self.burnDownloads()
+                tabsBurned()
             }
 
             self.burnRecentlyClosed()
@@ -239,9 +262,9 @@ final class Fire {
                 self.closeWindows(entity: entity)
 
                 self.burningData = nil
-                completion?()
+                self.finishBurnPhases()
 
-                Logger.fire.debug("Fire finished")
+                completion?()
             }
         }
     }
@@ -286,6 +309,34 @@ final class Fire {
         }
     }
 
+    // MARK: - Burn phases
+
+    /// Enters the burning group for the `phase` and returns the completion handler recording its duration and leaving the group.
+    /// Phases depending on the `phase` should be entered before it completes so the group isn‘t left empty in between.
+    @MainActor
+    private func beginPhase(_ phase: BurnPhase, in group: DispatchGroup) -> () -> Void {
+        group.enter()
+        let startTime = ProcessInfo.processInfo.systemUptime
+        return {
+            let duration = ProcessInfo.processInfo.systemUptime - startTime
+            DispatchQueue.main.asyncOrNow {
+                self.burnPhaseDurations[phase] = duration
+                group.leave()
+            }
+        }
+    }
+
+    @MainActor
+    private func finishBurnPhases() {
+        lastBurnPhaseDurations = burnPhaseDurations
+        burnPhaseDurations = [:]
+
+        let phases = lastBurnPhaseDurations.sorted { $0.value > $1.value }
+            .map { "\($0.key.rawValue): \(String(format: "%.3f", $0.value))s" }
+            .joined(separator: ", ")
+        Logger.fire.debug("Fire finished (\(phases))")
+    }
+
     // MARK: - Fire animation
 
     func fireAnimationDidStart() {
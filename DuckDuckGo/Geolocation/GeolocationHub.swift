@@ -0,0 +1,156 @@
+//
+//  GeolocationHub.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Combine
+import CoreLocation
+import Foundation
+
+/// Fans out location updates from a single `GeolocationService` subscription to all the Geolocation Providers.
+///
+/// Each location fix is wrapped into one immutable `GeolocationPosition` shared by all the subscribers,
+/// updates are throttled per subscriber and high accuracy requests are reference-counted across the subscribers.
+/// Should be used on the main thread.
+final class GeolocationHub {
+
+    static let shared = GeolocationHub(geolocationService: GeolocationService.shared)
+
+    /// Updates received within `minimumInterval` after the last delivered update are skipped
+    /// unless the location moved by at least `minimumDistance` or its accuracy improved.
+    struct Throttle: Equatable {
+        var minimumDistance: CLLocationDistance
+        var minimumInterval: TimeInterval
+
+        static let none = Throttle(minimumDistance: 0, minimumInterval: 0)
+        static let `default` = Throttle(minimumDistance: 1, minimumInterval: 1)
+
+        func shouldSkip(_ location: CLLocation, after lastLocation: CLLocation) -> Bool {
+            location.timestamp.timeIntervalSince(lastLocation.timestamp) < minimumInterval
+            && location.distance(from: lastLocation) < minimumDistance
+            && location.horizontalAccuracy >= lastLocation.horizontalAccuracy
+        }
+    }
+
+    typealias Update = Result<GeolocationPosition, Error>
+
+    private final class Subscriber {
+        let throttle: Throttle
+        let onUpdate: (Update) -> Void
+        var lastDeliveredLocation: CLLocation?
+
+        init(throttle: Throttle, onUpdate: @escaping (Update) -> Void) {
+            self.throttle = throttle
+            self.onUpdate = onUpdate
+        }
+    }
+
+    let geolocationService: GeolocationServiceProtocol
+
+    private var subscribers = [ObjectIdentifier: Subscriber]()
+    private var locationCancellable: AnyCancellable?
+    private(set) var lastUpdate: Update?
+
+    private var highAccuracyCancellable: AnyCancellable?
+    private var highAccuracyRequestsCount = 0 {
+        didSet {
+            assert(highAccuracyRequestsCount >= 0)
+            switch (oldValue, highAccuracyRequestsCount) {
+            case (0, 1):
+                highAccuracyCancellable = geolocationService.highAccuracyPublisher.sink { _ in }
+            case (1, 0):
+                highAccuracyCancellable = nil
+            default: break
+            }
+        }
+    }
+
+    init(geolocationService: GeolocationServiceProtocol) {
+        self.geolocationService = geolocationService
+    }
+
+    /// Subscribes to location updates, the last received update is delivered immediately if available.
+    /// - Returns: cancellable removing the subscription; the service subscription is cancelled with the last subscriber.
+    func subscribe(throttle: Throttle = .default, onUpdate: @escaping (Update) -> Void) -> AnyCancellable {
+        dispatchPrecondition(condition: .onQueue(.main))
+
+        let subscriber = Subscriber(throttle: throttle, onUpdate: onUpdate)
+        let id = ObjectIdentifier(subscriber)
+        subscribers[id] = subscriber
+
+        if locationCancellable == nil {
+            // the service publishes its current location on subscription
+            locationCancellable = geolocationService.locationPublisher.sink { [weak self] result in
+                self?.locationDidChange(result)
+            }
+        } else if let lastUpdate {
+            deliver(lastUpdate, to: subscriber)
+        }
+
+        return AnyCancellable { [weak self] in
+            self?.removeSubscriber(withId: id)
+        }
+    }
+
+    /// Keeps the high accuracy location updates enabled until the returned cancellable is cancelled or released.
+    func requestHighAccuracy() -> AnyCancellable {
+        dispatchPrecondition(condition: .onQueue(.main))
+
+        highAccuracyRequestsCount += 1
+        return AnyCancellable { [weak self] in
+            self?.highAccuracyRequestsCount -= 1
+        }
+    }
+
+    private func removeSubscriber(withId id: ObjectIdentifier) {
+        guard subscribers.removeValue(forKey: id) != nil, subscribers.isEmpty else { return }
+
+        locationCancellable?.cancel()
+        locationCancellable = nil
+        lastUpdate = nil
+    }
+
+    private func locationDidChange(_ result: Result<CLLocation, Error>?) {
+        guard let result else {
+            lastUpdate = nil
+            return
+        }
+        // one position object per fix shared by all the subscribers
+        let update = result.map(GeolocationPosition.init)
+        lastUpdate = update
+
+        for id in Array(subscribers.keys) {
+            // subscriber may be removed by a previous subscriber callback
+            guard let subscriber = subscribers[id] else { continue }
+            deliver(update, to: subscriber)
+        }
+    }
+
+    private func deliver(_ update: Update, to subscriber: Subscriber) {
+        switch update {
+        case .success(let position):
+            if let lastLocation = subscriber.lastDeliveredLocation,
+               subscriber.throttle.shouldSkip(position.location, after: lastLocation) {
+                return
+            }
+            subscriber.lastDeliveredLocation = position.location
+        case .failure:
+            subscriber.lastDeliveredLocation = nil
+        }
+        subscriber.onUpdate(update)
+    }
+
+}
@@ -37,7 +37,7 @@ protocol GeolocationProviderProtocol: AnyObject {
 }
 
 final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
-    private let geolocationService: GeolocationServiceProtocol
+    private let geolocationHub: GeolocationHub
     private var geolocationManager: WKGeolocationManager
     private var geolocationProviderCallbacks: UnsafeRawPointer?
     private var locationCancellable: AnyCancellable?
@@ -90,14 +90,14 @@ final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
     }
 
     var authorizationStatusPublisher: AnyPublisher<CLAuthorizationStatus, Never> {
-        self.geolocationService.authorizationStatusPublisher
+        self.geolocationHub.geolocationService.authorizationStatusPublisher
     }
     var authorizationStatus: CLAuthorizationStatus {
-        self.geolocationService.authorizationStatus
+        self.geolocationHub.geolocationService.authorizationStatus
     }
 
     init?<P: Publisher>(processPool: WKProcessPool,
-                        geolocationService: GeolocationServiceProtocol = GeolocationService.shared,
+                        geolocationHub: GeolocationHub = .shared,
                         appIsActivePublisher: P) where P.Output == Bool, P.Failure == Never {
 
         guard let geolocationManager = processPool.geolocationManager else {
@@ -106,7 +106,7 @@ final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
         }
 
         self.geolocationManager = geolocationManager
-        self.geolocationService = geolocationService
+        self.geolocationHub = geolocationHub
         super.init()
 
         geolocationProviderCallbacks = geolocationManager.setProvider(self)
@@ -114,9 +114,9 @@ final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
     }
 
     convenience init?(processPool: WKProcessPool,
-                      geolocationService: GeolocationServiceProtocol = GeolocationService.shared) {
+                      geolocationHub: GeolocationHub = .shared) {
         self.init(processPool: processPool,
-                  geolocationService: geolocationService,
+                  geolocationHub: geolocationHub,
                   appIsActivePublisher: NSApp.isActivePublisher())
     }
 
@@ -146,8 +146,8 @@ final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
             return
         }
 
-        locationCancellable = geolocationService.locationPublisher.sink { [weak self] result in
-            self?.updateLocation(with: result)
+        locationCancellable = geolocationHub.subscribe { [weak self] update in
+            self?.updateLocation(with: update)
         }
     }
 
@@ -160,7 +160,7 @@ final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
         self.isActive = true
     }
 
-    private func updateLocation(with result: Result<CLLocation, Error>?) {
+    private func updateLocation(with update: GeolocationHub.Update) {
         guard self.isActive else { return }
         guard !self.isRevoked else {
             geolocationManager.providerDidFailToDeterminePosition(GeolocationDisabled())
@@ -168,11 +168,9 @@ final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
         }
         guard !self.isPaused else { return }
 
-        switch result {
-        case .none:
-            break
-        case .success(let location):
-            geolocationManager.providerDidChangePosition(location)
+        switch update {
+        case .success(let position):
+            geolocationManager.providerDidChangePosition(position)
         case .failure(let error):
             geolocationManager.providerDidFailToDeterminePosition(error)
         }
@@ -186,7 +184,7 @@ final class GeolocationProvider: NSObject, GeolocationProviderProtocol {
     }
 
     fileprivate func geolocationManager(_ geolocationManager: WKGeolocationManager, setEnableHighAccuracyCallback enable: Bool) {
-        highAccuracyCancellable = enable ? geolocationService.highAccuracyPublisher.sink { _ in } : nil
+        highAccuracyCancellable = enable ? geolocationHub.requestHighAccuracy() : nil
     }
 
 }
@@ -254,10 +252,9 @@ private struct WKGeolocationManager {
         return UnsafeRawPointer(providerCallbacks)
     }
 
-    func providerDidChangePosition(_ location: CLLocation) {
-        guard let position = createWKGeolocationPosition(location) else { return }
-        WKGeolocationManager.providerDidChangePosition?(geolocationManager, position)
-        position.deallocate()
+    func providerDidChangePosition(_ position: GeolocationPosition) {
+        guard let webKitPosition = position.webKitPosition else { return }
+        WKGeolocationManager.providerDidChangePosition?(geolocationManager, webKitPosition)
     }
 
     func providerDidFailToDeterminePosition(_ error: Error?) {
@@ -277,6 +274,30 @@ private typealias WKGeolocationPositionCreate_c_type =  @convention(c) // swiftl
 private let WKGeolocationPositionCreate_c: WKGeolocationPositionCreate_c_type? = // swiftlint:disable:this identifier_name
     dynamicSymbol(named: "WKGeolocationPositionCreate_c")
 
+// https://github.com/WebKit/WebKit/blob/8afe31a018b11741abdf9b4d5bb973d7c1d9ff05/Source/WebKit/Shared/API/c/WKType.h
+private typealias WKReleaseType = @convention(c) (UnsafeRawPointer?) -> Void
+private let WKRelease: WKReleaseType? = dynamicSymbol(named: "WKRelease") // swiftlint:disable:this identifier_name
+
+/// Immutable location fix shared by all the Geolocation Managers receiving it:
+/// the WebKit position object is created once per fix instead of once per Process Pool.
+final class GeolocationPosition {
+
+    let location: CLLocation
+    fileprivate let webKitPosition: UnsafeRawPointer?
+
+    init(location: CLLocation) {
+        self.location = location
+        self.webKitPosition = createWKGeolocationPosition(location)
+    }
+
+    deinit {
+        if let webKitPosition {
+            WKRelease?(webKitPosition)
+        }
+    }
+
+}
+
 private func createWKGeolocationPosition(_ location: CLLocation) -> UnsafeRawPointer? {
     WKGeolocationPositionCreate_c?(/*timestamp:*/ location.timestamp.timeIntervalSinceReferenceDate,
                                    /*latitude:*/ location.coordinate.latitude,
@@ -113,6 +113,8 @@ final class EncryptedHistoryStore: HistoryStoring {
     private func reload(_ context: NSManagedObjectContext) -> Result<BrowsingHistory, Error> {
         let fetchRequest = HistoryEntryManagedObject.fetchRequest() as NSFetchRequest<HistoryEntryManagedObject>
         fetchRequest.returnsObjectsAsFaults = false
+        // Fetch the visits in one batch instead of faulting them in entry by entry
+        fetchRequest.relationshipKeyPathsForPrefetching = [#keyPath(HistoryEntryManagedObject.visits)]
         do {
             let historyEntries = try context.fetch(fetchRequest)
             Logger.history.debug("\(historyEntries.count) entries loaded from history")
@@ -332,18 +334,23 @@ final class EncryptedHistoryStore: HistoryStoring {
 fileprivate extension BrowsingHistory {
 
     init(historyEntries: [HistoryEntryManagedObject]) {
-        self = historyEntries.reduce(into: BrowsingHistory(), {
-            if let historyEntry = HistoryEntry(historyEntryMO: $1) {
-                $0.append(historyEntry)
+        var trackingEntitiesCache = [String: Set<String>]()
+        self = BrowsingHistory()
+        self.reserveCapacity(historyEntries.count)
+        for historyEntryMO in historyEntries {
+            if let historyEntry = HistoryEntry(historyEntryMO: historyEntryMO, trackingEntitiesCache: &trackingEntitiesCache) {
+                self.append(historyEntry)
             }
-        })
+        }
     }
 
 }
 
 fileprivate extension HistoryEntry {
 
-    convenience init?(historyEntryMO: HistoryEntryManagedObject) {
+    /// - Parameter trackingEntitiesCache: parsed blocked tracking entity sets by their stored representation;
+    ///   most entries share a few distinct sets, so they're split and hashed once and share the storage.
+    convenience init?(historyEntryMO: HistoryEntryManagedObject, trackingEntitiesCache: inout [String: Set<String>]) {
         guard let url = historyEntryMO.urlEncrypted as? URL,
               let identifier = historyEntryMO.identifier,
               let lastVisit = historyEntryMO.lastVisit else {
@@ -355,7 +362,14 @@ fileprivate extension HistoryEntry {
         let title = historyEntryMO.titleEncrypted as? String
         let numberOfTotalVisits = historyEntryMO.numberOfTotalVisits
         let numberOfTrackersBlocked = historyEntryMO.numberOfTrackersBlocked
-        let blockedTrackingEntities = historyEntryMO.blockedTrackingEntities ?? ""
+        let storedBlockedTrackingEntities = historyEntryMO.blockedTrackingEntities ?? ""
+        let blockedTrackingEntities: Set<String>
+        if let cachedEntities = trackingEntitiesCache[storedBlockedTrackingEntities] {
+            blockedTrackingEntities = cachedEntities
+        } else {
+            blockedTrackingEntities = Set(storedBlockedTrackingEntities.components(separatedBy: "|"))
+            trackingEntitiesCache[storedBlockedTrackingEntities] = blockedTrackingEntities
+        }
         let visits = Set(historyEntryMO.visits?.allObjects.compactMap {
             Visit(visitMO: $0 as? VisitManagedObject)
         } ?? [])
@@ -370,7 +384,7 @@ fileprivate extension HistoryEntry {
                   lastVisit: lastVisit,
                   visits: visits,
                   numberOfTrackersBlocked: Int(numberOfTrackersBlocked),
-                  blockedTrackingEntities: Set<String>(blockedTrackingEntities.components(separatedBy: "|")),
+                  blockedTrackingEntities: blockedTrackingEntities,
                   trackersFound: historyEntryMO.trackersFound)
 
         visits.forEach { visit in
@@ -56,20 +56,33 @@ final class HistoryGroupingProvider {
      * Returns visits for a given day.
      */
     func getRecentVisits(maxCount: Int) -> [Visit] {
-        removeDuplicatesIfNeeded(from: getSortedArrayOfVisits())
-            .prefix(maxCount)
-            .filter { Calendar.current.isDateInToday($0.date) }
+        // Only today's visits are sorted; the most recent visit of a URL visited today is always today's
+        let today = Date.startOfDayToday..<Date.startOfDayTomorrow
+        return Array(removeDuplicatesIfNeeded(from: getSortedArrayOfVisits(in: today)).prefix(maxCount))
     }
 
     /**
      * Returns history visits bucketed per day.
      */
     func getVisitGroupings() -> [HistoryGrouping] {
-        Dictionary(grouping: getSortedArrayOfVisits(), by: \.date.startOfDay)
-            .map { date, sortedVisits in
-                HistoryGrouping(date: date, visits: removeDuplicatesIfNeeded(from: sortedVisits))
+        // Visits are sorted, so each day is a contiguous run and the start of the day is only computed once per day
+        var groupings = [HistoryGrouping]()
+        var dayStart = Date.distantFuture
+        var dayVisits = [Visit]()
+        for visit in getSortedArrayOfVisits() {
+            if visit.date < dayStart {
+                if !dayVisits.isEmpty {
+                    groupings.append(HistoryGrouping(date: dayStart, visits: removeDuplicatesIfNeeded(from: dayVisits)))
+                    dayVisits.removeAll(keepingCapacity: true)
+                }
+                dayStart = visit.date.startOfDay
             }
-            .sorted { $0.date > $1.date }
+            dayVisits.append(visit)
+        }
+        if !dayVisits.isEmpty {
+            groupings.append(HistoryGrouping(date: dayStart, visits: removeDuplicatesIfNeeded(from: dayVisits)))
+        }
+        return groupings
     }
 
     private func removeDuplicatesIfNeeded(from sortedVisits: [Visit]) -> [Visit] {
@@ -84,11 +97,20 @@ final class HistoryGroupingProvider {
         return sortedVisits.removingDuplicates(byKey: \.historyEntry?.url)
     }
 
-    private func getSortedArrayOfVisits() -> [Visit] {
+    /// Returns the visits (optionally limited to a date range) sorted by date, most recent first.
+    private func getSortedArrayOfVisits(in dateRange: Range<Date>? = nil) -> [Visit] {
         guard let history = dataSource?.history else {
             Logger.general.error("HistoryCoordinator: No history available")
             return []
         }
-        return history.flatMap(\.visits).sorted { $0.date > $1.date }
+        // Sort by the raw timestamps instead of accessing the visit dates in the comparator
+        var visits = [(timestamp: TimeInterval, visit: Visit)]()
+        for entry in history {
+            for visit in entry.visits where dateRange?.contains(visit.date) ?? true {
+                visits.append((visit.date.timeIntervalSinceReferenceDate, visit))
+            }
+        }
+        visits.sort { $0.timestamp > $1.timestamp }
+        return visits.map(\.visit)
     }
 }
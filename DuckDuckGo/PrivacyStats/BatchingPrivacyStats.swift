@@ -0,0 +1,179 @@
+//
+//  BatchingPrivacyStats.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Combine
+import Foundation
+import PrivacyStats
+
+/// Privacy stats counting blocked trackers synchronously, so the content blocking path doesn‘t need a task per tracker.
+protocol BlockedTrackersCounting: PrivacyStatsCollecting {
+    func countBlockedTracker(_ name: String)
+}
+
+/// Counts the blocked trackers in memory and records them in the privacy stats store once per `flushInterval`.
+///
+/// `PrivacyStats` already buffers the counts before saving them to the database, but it only takes one tracker per async
+/// call, so the content blocking path had to spawn a task for every blocked tracker. Counting here keeps that path
+/// synchronous, and a single task per `flushInterval` hands the counts over to the store one tracker at a time.
+/// The New Tab Page stats are served from memory, fetched from the store again only once it‘s updated or the day changes.
+///
+/// Store writes, clearing and store fetches are serialized, so a fetch never sees counts both in the store and in memory,
+/// and clearing the stats can‘t be followed by a write of counts collected before it.
+final class BatchingPrivacyStats: BlockedTrackersCounting {
+
+    let statsUpdatePublisher: AnyPublisher<Void, Never>
+
+    private let store: PrivacyStatsCollecting
+    private let flushInterval: TimeInterval
+    private let currentDate: () -> Date
+
+    private let lock = NSLock()
+    /// counts not handed over to the store yet
+    private var pendingCounts = [String: Int64]()
+    /// counts being recorded in the store
+    private var flushingCounts = [String: Int64]()
+    private var isFlushScheduled = false
+    private var cachedStats: (day: Date, stats: [String: Int64])?
+    /// awaits the last store operation, called by the next one
+    private var awaitLastStoreOperation: (() async -> Void)?
+
+    private let statsUpdateSubject = PassthroughSubject<Void, Never>()
+    private var cancellable: AnyCancellable?
+
+    init(store: PrivacyStatsCollecting, flushInterval: TimeInterval = 1, currentDate: @escaping () -> Date = Date.init) {
+        self.store = store
+        self.flushInterval = flushInterval
+        self.currentDate = currentDate
+        self.statsUpdatePublisher = statsUpdateSubject.eraseToAnyPublisher()
+
+        // invalidate the cached stats before the subscribers fetch the updated stats
+        cancellable = store.statsUpdatePublisher.sink { [weak self] in
+            guard let self else { return }
+            lock.withLock {
+                self.cachedStats = nil
+            }
+            statsUpdateSubject.send()
+        }
+    }
+
+    /// Counts the blocked tracker without suspending.
+    func countBlockedTracker(_ name: String) {
+        let shouldScheduleFlush = lock.withLock {
+            pendingCounts[name, default: 0] += 1
+            guard !isFlushScheduled else { return false }
+            isFlushScheduled = true
+            return true
+        }
+        guard shouldScheduleFlush else { return }
+
+        DispatchQueue.global(qos: .utility).asyncAfter(deadline: .now() + flushInterval) { [weak self] in
+            Task {
+                await self?.flush()
+            }
+        }
+    }
+
+    func recordBlockedTracker(_ name: String) async {
+        countBlockedTracker(name)
+    }
+
+    /// Hands the pending counts over to the store.
+    func flush() async {
+        await performStoreOperation { [self] in
+            let counts = lock.withLock {
+                let counts = pendingCounts
+                pendingCounts = [:]
+                isFlushScheduled = false
+                flushingCounts.merge(counts, uniquingKeysWith: +)
+                return counts
+            }
+            guard !counts.isEmpty else { return }
+
+            for (name, count) in counts {
+                for _ in 0..<count {
+                    await store.recordBlockedTracker(name)
+                }
+            }
+
+            lock.withLock {
+                for (name, count) in counts {
+                    let remainingCount = (flushingCounts[name] ?? 0) - count
+                    flushingCounts[name] = remainingCount > 0 ? remainingCount : nil
+                }
+                cachedStats = nil
+            }
+        }
+    }
+
+    func fetchPrivacyStats() async -> [String: Int64] {
+        let day = Calendar.current.startOfDay(for: currentDate())
+
+        let stats = lock.withLock {
+            cachedStats.flatMap { $0.day == day ? mergingCountsInMemory(into: $0.stats) : nil }
+        }
+        if let stats {
+            return stats
+        }
+
+        return await performStoreOperation { [self] in
+            let stats = await store.fetchPrivacyStats()
+            return lock.withLock {
+                cachedStats = (day, stats)
+                return mergingCountsInMemory(into: stats)
+            }
+        }
+    }
+
+    func clearPrivacyStats() async {
+        await performStoreOperation { [self] in
+            lock.withLock {
+                pendingCounts = [:]
+                flushingCounts = [:]
+                cachedStats = nil
+            }
+            await store.clearPrivacyStats()
+        }
+    }
+
+    func handleAppTermination() async {
+        await flush()
+        await store.handleAppTermination()
+    }
+
+    /// Must be called with the `lock` held.
+    private func mergingCountsInMemory(into stats: [String: Int64]) -> [String: Int64] {
+        stats.merging(pendingCounts, uniquingKeysWith: +).merging(flushingCounts, uniquingKeysWith: +)
+    }
+
+    /// Runs `operation` once all the previously started store operations have finished.
+    private func performStoreOperation<T: Sendable>(_ operation: @escaping () async -> T) async -> T {
+        let task = lock.withLock {
+            let awaitPreviousOperation = awaitLastStoreOperation
+            let task = Task {
+                await awaitPreviousOperation?()
+                return await operation()
+            }
+            awaitLastStoreOperation = {
+                _ = await task.value
+            }
+            return task
+        }
+        return await task.value
+    }
+
+}
@@ -21,7 +21,8 @@
 import Combine
 import PrivacyStats
 
-final class MockPrivacyStats: PrivacyStatsCollecting {
+final class MockPrivacyStats: BlockedTrackersCounting {
+    func countBlockedTracker(_ name: String) {}
     func recordBlockedTracker(_ name: String) async {}
     let statsUpdatePublisher: AnyPublisher<Void, Never> = PassthroughSubject<Void, Never>().eraseToAnyPublisher()
     func fetchPrivacyStats() async -> [String: Int64] { [:] }
@@ -82,7 +82,12 @@ final class AppStateRestorationManager: NSObject {
     }
 
     func clearLastSessionState() {
-        service.clearState(sync: true)
+        // lazily restored tabs still load their session state from the persisted chunks when they‘re displayed
+        let tabs = WindowControllersManager.shared.allTabCollectionViewModels.flatMap { $0.tabCollection.tabs }
+            + WindowControllersManager.shared.pinnedTabsManager.tabCollection.tabs
+        let pendingChunkKeys = Set(tabs.compactMap { $0.pendingInteractionStateChunk?.key })
+
+        service.clearState(keepingChunks: pendingChunkKeys, sync: true)
     }
 
     // Cleans all stored snapshots except snapshots listed in the state
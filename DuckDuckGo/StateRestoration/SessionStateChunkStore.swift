@@ -0,0 +1,197 @@
+//
+//  SessionStateChunkStore.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CryptoKit
+import Foundation
+import os.log
+
+/// Stores large session state blobs (tab interaction state) outside of the app state archive.
+///
+/// Each blob is saved once as an immutable LZ4-compressed chunk named by its SHA-256 digest, and the archive only
+/// references the chunk keys, so saving the state only writes the chunks of the tabs that changed.
+/// Chunks not referenced by the persisted archives are removed by `removeChunks(notIn:)`.
+final class SessionStateChunkStore {
+
+    private let fileStore: FileStore
+    private let directoryURL: URL
+    /// keys of the chunks known to be written, accessed on the persistence queue
+    private var persistedKeys = Set<String>()
+
+    init(fileStore: FileStore, directoryName: String) {
+        self.fileStore = fileStore
+        self.directoryURL = URL.persistenceLocation(for: directoryName)
+    }
+
+    static func key(for data: Data) -> String {
+        SHA256.hash(data: data).map { String(format: "%02x", $0) }.joined()
+    }
+
+    /// Writes the chunks that are not persisted yet.
+    /// - Returns: `false` if any of the chunks could not be written.
+    func persist(_ chunks: [String: Data]) -> Bool {
+        guard !chunks.isEmpty else { return true }
+        createDirectoryIfNeeded()
+
+        var result = true
+        for (key, data) in chunks where !persistedKeys.contains(key) {
+            let url = chunkURL(forKey: key)
+            // written chunks are immutable
+            if fileStore.hasData(at: url) {
+                persistedKeys.insert(key)
+                continue
+            }
+            guard let compressed = try? (data as NSData).compressed(using: .lz4) as Data,
+                  fileStore.persist(compressed, url: url) else {
+                Logger.general.error("SessionStateChunkStore: could not write chunk \(key, privacy: .public)")
+                result = false
+                continue
+            }
+            persistedKeys.insert(key)
+        }
+        return result
+    }
+
+    func loadChunk(forKey key: String) -> Data? {
+        guard let compressed = fileStore.loadData(at: chunkURL(forKey: key)) else { return nil }
+        return try? (compressed as NSData).decompressed(using: .lz4) as Data
+    }
+
+    /// Compaction: removes the chunks not referenced by `keys`.
+    func removeChunks(notIn keys: Set<String>) {
+        guard let fileNames = try? fileStore.directoryContents(at: directoryURL.path) else { return }
+        for fileName in fileNames where !keys.contains(fileName) {
+            fileStore.remove(fileAtURL: chunkURL(forKey: fileName))
+            persistedKeys.remove(fileName)
+        }
+    }
+
+    private func chunkURL(forKey key: String) -> URL {
+        directoryURL.appendingPathComponent(key)
+    }
+
+    private func createDirectoryIfNeeded() {
+        guard !FileManager.default.fileExists(atPath: directoryURL.path) else { return }
+        do {
+            try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true, attributes: nil)
+        } catch {
+            Logger.general.error("SessionStateChunkStore: could not create directory: \(error.localizedDescription)")
+        }
+    }
+
+}
+
+/// Chunk referenced by a restored session state, loaded from the `SessionStateChunkStore` on first access.
+/// Can be prefetched on a background queue.
+final class SessionStateChunk {
+
+    let key: String
+    private let loader: (String) -> Data?
+    private let lock = NSLock()
+    private var loadedData: Data??
+
+    init(key: String, loader: @escaping (String) -> Data?) {
+        self.key = key
+        self.loader = loader
+    }
+
+    var data: Data? {
+        lock.withLock {
+            if let loadedData {
+                return loadedData
+            }
+            let data = loader(key)
+            loadedData = .some(data)
+            return data
+        }
+    }
+
+    func prefetch() {
+        _=data
+    }
+
+}
+
+/// Keyed archiver collecting the large blobs as chunks instead of encoding them inline.
+final class SessionStateArchiver: NSKeyedArchiver {
+
+    static let chunkKeysKey = "chunkKeys"
+
+    /// new chunk data to persist
+    private(set) var chunks = [String: Data]()
+    /// all the chunks referenced by the archive
+    private(set) var referencedChunkKeys = Set<String>()
+
+    /// Encodes a reference to the `data` chunk stored in the `SessionStateChunkStore`.
+    func encodeChunk(_ data: Data, forKey key: String) {
+        let chunkKey = SessionStateChunkStore.key(for: data)
+        chunks[chunkKey] = data
+        referencedChunkKeys.insert(chunkKey)
+        encode(chunkKey, forKey: key)
+    }
+
+    /// Encodes a reference to an already persisted chunk without loading its data.
+    func encodeChunk(_ chunk: SessionStateChunk, forKey key: String) {
+        referencedChunkKeys.insert(chunk.key)
+        encode(chunk.key, forKey: key)
+    }
+
+    /// Encodes the list of the referenced chunks at the archive root, called once the state is encoded.
+    func encodeChunkKeys() {
+        encode(Array(referencedChunkKeys), forKey: Self.chunkKeysKey)
+    }
+
+}
+
+/// Keyed unarchiver resolving the chunk references encoded by `SessionStateArchiver`.
+/// The chunks are not loaded while decoding: they are loaded on first access or by `prefetchChunks`.
+final class SessionStateUnarchiver: NSKeyedUnarchiver {
+
+    var chunkLoader: ((String) -> Data?)?
+    private var decodedChunks = [(chunk: SessionStateChunk, priority: Date)]()
+
+    /// - Parameter prefetchPriority: chunks with the later dates are prefetched first (e.g. the last tab selection date).
+    func decodeChunk(forKey key: String, prefetchPriority: Date? = nil) -> SessionStateChunk? {
+        guard let chunkKey = decodeObject(of: NSString.self, forKey: key) as String?,
+              let chunkLoader else { return nil }
+
+        let chunk = SessionStateChunk(key: chunkKey, loader: chunkLoader)
+        decodedChunks.append((chunk, prefetchPriority ?? .distantPast))
+        return chunk
+    }
+
+    /// Loads up to `limit` most recently used decoded chunks one by one on the `queue`.
+    func prefetchChunks(limit: Int, on queue: DispatchQueue) {
+        let chunks = decodedChunks.sorted { $0.priority > $1.priority }.prefix(limit).map(\.chunk)
+        for chunk in chunks {
+            // one chunk per work item: the queue can run other work in between
+            queue.async {
+                chunk.prefetch()
+            }
+        }
+    }
+
+    /// Reads the chunk keys referenced by an archive without decoding the archived state.
+    static func chunkKeys(in archive: Data) -> Set<String>? {
+        guard let unarchiver = try? NSKeyedUnarchiver(forReadingFrom: archive) else { return nil }
+        defer { unarchiver.finishDecoding() }
+        // archives written before the chunk store was introduced don‘t reference any chunks
+        let chunkKeys = unarchiver.decodeObject(of: [NSArray.self, NSString.self], forKey: SessionStateArchiver.chunkKeysKey) as? [String]
+        return Set(chunkKeys ?? [])
+    }
+
+}
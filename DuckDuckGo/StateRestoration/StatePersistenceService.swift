@@ -33,6 +33,15 @@ final class StatePersistenceService {
     private let queue = DispatchQueue(label: "StateRestorationManager.queue", qos: .background)
     private var job: DispatchWorkItem?
 
+    /// Tab session state blobs are stored as separate chunks, only the changed ones are written
+    private let chunkStore: SessionStateChunkStore
+    /// unreferenced chunks are removed on the first write and every `compactionInterval` writes after, accessed on the `queue`
+    private static let compactionInterval = 50
+    private var writesSinceCompaction: Int?
+    /// number of the most recently used tabs session state chunks loaded in background after the state is restored
+    private static let prefetchedChunksLimit = 20
+    private let prefetchQueue = DispatchQueue(label: "StateRestorationManager.prefetchQueue", qos: .background)
+
     private(set) var error: Error?
 
     /// `false` if `persistentState` or `persistentState.1` file exists,
@@ -48,6 +57,7 @@ final class StatePersistenceService {
     init(fileStore: FileStore, fileName: String) {
         self.fileStore = fileStore
         self.fileName = fileName
+        self.chunkStore = SessionStateChunkStore(fileStore: fileStore, directoryName: fileName + ".chunks")
     }
 
     var canRestoreLastSessionState: Bool {
@@ -58,16 +68,17 @@ final class StatePersistenceService {
     func persistState(using encoder: @escaping @MainActor (NSCoder) -> Void, sync: Bool = false) {
         dispatchPrecondition(condition: .onQueue(.main))
 
-        let data = archive(using: encoder)
-        write(data, sync: sync)
+        let (data, chunks, referencedChunkKeys) = archive(using: encoder)
+        write(data, chunks: chunks, referencedChunkKeys: referencedChunkKeys, sync: sync)
     }
 
-    func clearState(sync: Bool = false) {
+    /// - Parameter chunkKeys: session state chunks to keep, still referenced by the open tabs that haven‘t loaded them yet
+    func clearState(keepingChunks chunkKeys: Set<String> = [], sync: Bool = false) {
         dispatchPrecondition(condition: .onQueue(.main))
 
         job?.cancel()
         job = DispatchWorkItem {
-            self.performClearState()
+            self.performClearState(keepingChunks: chunkKeys)
         }
         queue.dispatch(job!, sync: sync)
     }
@@ -81,12 +92,15 @@ final class StatePersistenceService {
     }
 
     // perform state clearing synchronously, called from `clearState(sync:)` on `StateRestorationManager.queue`
-    func performClearState() {
+    func performClearState(keepingChunks chunkKeys: Set<String> = []) {
         lastSessionStateArchive = nil
         let location = URL.persistenceLocation(for: self.fileName)
         fileStore.remove(fileAtURL: location)
         fileStore.remove(fileAtURL: .persistenceLocation(for: self.lastLoadedStateFileName))
         fileStore.remove(fileAtURL: .persistenceLocation(for: self.oldStateFileName))
+        chunkStore.removeChunks(notIn: chunkKeys)
+        // compact on the next write: the kept chunks of the tabs closed since then are removed
+        writesSinceCompaction = nil
     }
 
     /// rename `persistentState` to `persistentState.1` after the state was loaded
@@ -117,26 +131,52 @@ final class StatePersistenceService {
     // MARK: - Private
 
     @MainActor
-    private func archive(using encoder: @escaping @MainActor (NSCoder) -> Void) -> Data {
-        let archiver = NSKeyedArchiver(requiringSecureCoding: true)
+    private func archive(using encoder: @escaping @MainActor (NSCoder) -> Void) -> (Data, chunks: [String: Data], referencedChunkKeys: Set<String>) {
+        let archiver = SessionStateArchiver(requiringSecureCoding: true)
         encoder(archiver)
-        return archiver.encodedData
+        archiver.encodeChunkKeys()
+        return (archiver.encodedData, archiver.chunks, archiver.referencedChunkKeys)
     }
 
-    private func write(_ data: Data, sync: Bool) {
+    private func write(_ data: Data, chunks: [String: Data], referencedChunkKeys: Set<String>, sync: Bool) {
         job?.cancel()
         job = DispatchWorkItem {
             self.error = nil
+            // the chunks are written before the archive referencing them
+            guard self.chunkStore.persist(chunks) else {
+                self.error = CocoaError(.fileWriteNoPermission)
+                return
+            }
             let location = URL.persistenceLocation(for: self.fileName)
             if !self.fileStore.persist(data, url: location) {
                 self.error = CocoaError(.fileWriteNoPermission)
             }
             self.fileStore.remove(fileAtURL: .persistenceLocation(for: self.lastLoadedStateFileName))
             self.fileStore.remove(fileAtURL: .persistenceLocation(for: self.oldStateFileName))
+
+            if self.error == nil {
+                self.compactChunksIfNeeded(referencedBy: referencedChunkKeys)
+            }
         }
         queue.dispatch(job!, sync: sync)
     }
 
+    /// Removes the chunks not referenced by the persisted state or by the last session state (that can still be restored).
+    private func compactChunksIfNeeded(referencedBy chunkKeys: Set<String>) {
+        if let writesSinceCompaction, writesSinceCompaction < Self.compactionInterval {
+            self.writesSinceCompaction = writesSinceCompaction + 1
+            return
+        }
+        var referencedKeys = chunkKeys
+        if let lastSessionStateArchive {
+            guard let data = fileStore.decrypt(lastSessionStateArchive),
+                  let lastSessionKeys = SessionStateUnarchiver.chunkKeys(in: data) else { return }
+            referencedKeys.formUnion(lastSessionKeys)
+        }
+        chunkStore.removeChunks(notIn: referencedKeys)
+        writesSinceCompaction = 0
+    }
+
     private func loadStateFromFile() -> Data? {
         fileStore.loadData(at: URL.persistenceLocation(for: self.fileName), decryptIfNeeded: false)
         ?? fileStore.loadData(at: .persistenceLocation(for: self.lastLoadedStateFileName), decryptIfNeeded: false)
@@ -148,8 +188,13 @@ final class StatePersistenceService {
         guard let data = fileStore.decrypt(archive) else {
             throw CocoaError(.fileReadNoSuchFile)
         }
-        let unarchiver = try NSKeyedUnarchiver(forReadingFrom: data)
+        let unarchiver = try SessionStateUnarchiver(forReadingFrom: data)
+        unarchiver.chunkLoader = { [chunkStore] key in
+            chunkStore.loadChunk(forKey: key)
+        }
         try restore(unarchiver)
+        // tabs session state is loaded when a tab is displayed, preload the most recently used ones
+        unarchiver.prefetchChunks(limit: Self.prefetchedChunksLimit, on: prefetchQueue)
     }
 
 }
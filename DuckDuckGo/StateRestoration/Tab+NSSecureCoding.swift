@@ -28,6 +28,7 @@ extension Tab: NSSecureCoding {
         static let title = "title"
         static let sessionStateData = "ssdata" // Used for session restoration on macOS 10.15 – 11
         static let interactionStateData = "interactionStateData" // Used for session restoration on macOS 12+
+        static let interactionStateChunk = "interactionStateChunk" // `interactionStateData` stored in the SessionStateChunkStore
         static let favicon = "icon"
         static let tabType = "tabType"
         static let preferencePane = "preferencePane"
@@ -49,14 +50,33 @@ extension Tab: NSSecureCoding {
               let content = TabContent(type: tabType, url: url, videoID: videoID, timestamp: videoTimestamp, preferencePane: preferencePane)
         else { return nil }
 
-        let interactionStateData: Data? = decoder.decodeIfPresent(at: NSSecureCodingKeys.interactionStateData) ?? decoder.decodeIfPresent(at: NSSecureCodingKeys.sessionStateData)
+        let lastSelectedAt: Date? = decoder.decodeIfPresent(at: NSSecureCodingKeys.lastSelectedAt)
+        var interactionStateChunk = (decoder as? SessionStateUnarchiver)?.decodeChunk(forKey: NSSecureCodingKeys.interactionStateChunk,
+                                                                                      prefetchPriority: lastSelectedAt)
+        var interactionStateData: Data?
+        switch tabType {
+        case .newtab, .bookmarks, .preferences:
+            // these pages are loaded on Tab init
+            interactionStateData = interactionStateChunk?.data
+            interactionStateChunk = nil
+        default:
+            // session state chunk is only loaded when the tab is displayed
+            break
+        }
+        if interactionStateChunk == nil, interactionStateData == nil {
+            interactionStateData = decoder.decodeIfPresent(at: NSSecureCodingKeys.interactionStateData) ?? decoder.decodeIfPresent(at: NSSecureCodingKeys.sessionStateData)
+        }
 
         self.init(content: content,
                   title: decoder.decodeIfPresent(at: NSSecureCodingKeys.title),
                   favicon: decoder.decodeIfPresent(at: NSSecureCodingKeys.favicon),
                   interactionStateData: interactionStateData,
                   shouldLoadInBackground: false,
-                  lastSelectedAt: decoder.decodeIfPresent(at: NSSecureCodingKeys.lastSelectedAt))
+                  lastSelectedAt: lastSelectedAt)
+
+        if let interactionStateChunk {
+            self.pendingInteractionStateChunk = interactionStateChunk
+        }
 
         _=self.awakeAfter(using: decoder)
     }
@@ -68,7 +88,16 @@ extension Tab: NSSecureCoding {
         title.map(coder.encode(forKey: NSSecureCodingKeys.title))
         favicon.map(coder.encode(forKey: NSSecureCodingKeys.favicon))
 
-        getActualInteractionStateData().map(coder.encode(forKey: NSSecureCodingKeys.interactionStateData))
+        if let archiver = coder as? SessionStateArchiver, let interactionStateChunk = pendingInteractionStateChunk {
+            // not loaded yet: keep referencing the persisted chunk
+            archiver.encodeChunk(interactionStateChunk, forKey: NSSecureCodingKeys.interactionStateChunk)
+        } else if let interactionStateData = getActualInteractionStateData() {
+            if let archiver = coder as? SessionStateArchiver {
+                archiver.encodeChunk(interactionStateData, forKey: NSSecureCodingKeys.interactionStateChunk)
+            } else {
+                coder.encode(interactionStateData, forKey: NSSecureCodingKeys.interactionStateData)
+            }
+        }
 
         coder.encode(content.type.rawValue, forKey: NSSecureCodingKeys.tabType)
         lastSelectedAt.map(coder.encode(forKey: NSSecureCodingKeys.lastSelectedAt))
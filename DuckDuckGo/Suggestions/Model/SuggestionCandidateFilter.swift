@@ -0,0 +1,90 @@
+//
+//  SuggestionCandidateFilter.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Narrows the local suggestion candidates (history entries, bookmarks) down to the ones that can match the query
+/// before they‘re passed to the suggestion loader, which scores every candidate it gets.
+///
+/// A candidate can only be scored if its title or URL contains every alphanumeric token of the query.
+/// While the user types, every query extends the previous one, so its candidates are a subset of the previous
+/// query candidates: only those are filtered again, using the normalized text computed on the first keystroke.
+final class SuggestionCandidateFilter<Candidate> {
+
+    private let searchableText: (Candidate) -> String
+
+    private var lastQueryTokens: [String]?
+    private var lastCandidates = [(candidate: Candidate, text: String)]()
+    private let lock = NSLock()
+
+    /// - Parameter searchableText: text of the candidate matched against the query (e.g. title and URL).
+    init(searchableText: @escaping (Candidate) -> String) {
+        self.searchableText = searchableText
+    }
+
+    /// Returns the candidates containing all the `query` tokens.
+    /// - Parameter source: all the candidates, only called when the previous query candidates can‘t be narrowed.
+    func candidates(matching query: String, in source: () -> [Candidate]) -> [Candidate] {
+        let queryTokens = Self.tokens(of: query)
+        guard !queryTokens.isEmpty else {
+            reset()
+            return source()
+        }
+
+        return lock.withLock {
+            let candidates: [(candidate: Candidate, text: String)]
+            if let lastQueryTokens = self.lastQueryTokens, Self.tokens(queryTokens, narrow: lastQueryTokens) {
+                candidates = lastCandidates
+            } else {
+                candidates = source().map { ($0, Self.normalize(searchableText($0))) }
+            }
+
+            lastCandidates = candidates.filter { _, text in
+                queryTokens.allSatisfy { text.contains($0) }
+            }
+            lastQueryTokens = queryTokens
+            return lastCandidates.map(\.candidate)
+        }
+    }
+
+    /// Forgets the last query candidates, should be called when the candidates source changes.
+    func reset() {
+        lock.withLock {
+            lastQueryTokens = nil
+            lastCandidates = []
+        }
+    }
+
+    // MARK: - Private
+
+    static func normalize(_ text: String) -> String {
+        text.folding(options: [.caseInsensitive, .diacriticInsensitive], locale: nil)
+    }
+
+    static func tokens(of query: String) -> [String] {
+        normalize(query).components(separatedBy: CharacterSet.alphanumerics.inverted).filter { !$0.isEmpty }
+    }
+
+    /// Returns `true` if every candidate containing all the `tokens` also contains all the `previousTokens`.
+    private static func tokens(_ tokens: [String], narrow previousTokens: [String]) -> Bool {
+        previousTokens.allSatisfy { previousToken in
+            tokens.contains { $0.contains(previousToken) }
+        }
+    }
+
+}
@@ -46,6 +46,15 @@ final class SuggestionContainer {
 
     private var latestQuery: Query?
 
+    // Local candidates narrowed down to the ones matching the latest query
+    private let historyFilter = SuggestionCandidateFilter<HistorySuggestion> { entry in
+        (entry.title ?? "") + " " + entry.url.absoluteString
+    }
+    private let bookmarksFilter = SuggestionCandidateFilter<Suggestions.Bookmark> { bookmark in
+        bookmark.title + " " + bookmark.url
+    }
+    private var candidatesSourceCancellables = Set<AnyCancellable>()
+
     fileprivate let suggestionsURLSession = URLSession(configuration: .ephemeral)
 
     init(openTabsProvider: @escaping OpenTabsProvider, suggestionLoading: SuggestionLoading, historyCoordinating: HistoryCoordinating, bookmarkManager: BookmarkManager, startupPreferences: StartupPreferences = .shared, featureFlagger: FeatureFlagger = NSApp.delegateTyped.featureFlagger, burnerMode: BurnerMode,
@@ -58,6 +67,13 @@ final class SuggestionContainer {
         self.loading = suggestionLoading
         self.burnerMode = burnerMode
         self.windowControllersManager = windowControllersManager ?? WindowControllersManager.shared
+
+        historyCoordinating.historyDictionaryPublisher
+            .sink { [historyFilter] _ in historyFilter.reset() }
+            .store(in: &candidatesSourceCancellables)
+        bookmarkManager.listPublisher
+            .sink { [bookmarksFilter] _ in bookmarksFilter.reset() }
+            .store(in: &candidatesSourceCancellables)
     }
 
     @MainActor
@@ -106,6 +122,8 @@ final class SuggestionContainer {
 
     func stopGettingSuggestions() {
         latestQuery = nil
+        historyFilter.reset()
+        bookmarksFilter.reset()
     }
 
     private static func defaultOpenTabsProvider(burnerMode: BurnerMode, windowControllersManager: WindowControllersManagerProtocol) -> OpenTabsProvider {
@@ -143,7 +161,12 @@ extension SuggestionContainer: SuggestionLoadingDataSource {
     }
 
     func history(for suggestionLoading: SuggestionLoading) -> [HistorySuggestion] {
-        return historyCoordinating.history ?? []
+        guard let latestQuery else {
+            return historyCoordinating.history ?? []
+        }
+        return historyFilter.candidates(matching: latestQuery) {
+            historyCoordinating.history ?? []
+        }
     }
 
     @MainActor func internalPages(for suggestionLoading: Suggestions.SuggestionLoading) -> [Suggestions.InternalPage] {
@@ -180,7 +203,12 @@ extension SuggestionContainer: SuggestionLoadingDataSource {
     }
 
     @MainActor func bookmarks(for suggestionLoading: SuggestionLoading) -> [Suggestions.Bookmark] {
-        bookmarkManager.list?.bookmarks() ?? []
+        guard let latestQuery else {
+            return bookmarkManager.list?.bookmarks() ?? []
+        }
+        return bookmarksFilter.candidates(matching: latestQuery) {
+            bookmarkManager.list?.bookmarks() ?? []
+        }
     }
 
     @MainActor func openTabs(for suggestionLoading: any Suggestions.SuggestionLoading) -> [any Suggestions.BrowserTab] {
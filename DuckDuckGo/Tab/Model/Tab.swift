@@ -604,6 +604,8 @@ protocol NewWindowPolicyDecisionMaker {
     private enum InteractionState {
         case none
         case loadCachedFromTabContent(Data)
+        /// restored session state loaded when the Tab is displayed (or prefetched)
+        case loadFromSessionStateChunk(SessionStateChunk)
         case webViewProvided(Data)
 
         var data: Data? {
@@ -612,6 +614,8 @@ protocol NewWindowPolicyDecisionMaker {
                 return nil
             case .loadCachedFromTabContent(let data):
                 return data
+            case .loadFromSessionStateChunk(let chunk):
+                return chunk.data
             case .webViewProvided(let data):
                 return data
             }
@@ -623,6 +627,17 @@ protocol NewWindowPolicyDecisionMaker {
         interactionState = .none
     }
 
+    /// Session state chunk the Tab was restored with, until it‘s loaded into the WebView
+    var pendingInteractionStateChunk: SessionStateChunk? {
+        get {
+            guard case .loadFromSessionStateChunk(let chunk) = interactionState else { return nil }
+            return chunk
+        }
+        set {
+            interactionState = newValue.map(InteractionState.loadFromSessionStateChunk) ?? .none
+        }
+    }
+
     func getActualInteractionStateData() -> Data? {
         if let interactionStateData = interactionState.data {
             return interactionStateData
@@ -958,8 +973,20 @@ protocol NewWindowPolicyDecisionMaker {
 
     @MainActor
     private func restoreInteractionStateIfNeeded() -> Bool {
-        // only restore session from interactionStateData passed to Tab.init
-        guard case .loadCachedFromTabContent(let interactionStateData) = self.interactionState else { return false }
+        // only restore session from interactionStateData passed to Tab.init or decoded
+        let interactionStateData: Data
+        switch self.interactionState {
+        case .loadCachedFromTabContent(let data):
+            interactionStateData = data
+        case .loadFromSessionStateChunk(let chunk):
+            guard let data = chunk.data else {
+                invalidateInteractionStateData()
+                return false
+            }
+            interactionStateData = data
+        case .none, .webViewProvided:
+            return false
+        }
 
         switch content.urlForWebView {
         case .some(let url) where url.isFileURL:
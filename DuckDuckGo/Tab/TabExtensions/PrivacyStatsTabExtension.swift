@@ -25,10 +25,10 @@ import PrivacyStats
 
 final class PrivacyStatsTabExtension: NSObject {
 
-    let privacyStats: PrivacyStatsCollecting
+    let privacyStats: BlockedTrackersCounting
     private var cancellables = Set<AnyCancellable>()
 
-    init(privacyStats: PrivacyStatsCollecting = NSApp.delegateTyped.privacyStats, trackersPublisher: some Publisher<DetectedTracker, Never>) {
+    init(privacyStats: BlockedTrackersCounting = NSApp.delegateTyped.privacyStats, trackersPublisher: some Publisher<DetectedTracker, Never>) {
         self.privacyStats = privacyStats
         super.init()
 
@@ -45,9 +45,7 @@ final class PrivacyStatsTabExtension: NSObject {
         }
         switch tracker.type {
         case .tracker, .trackerWithSurrogate:
-            Task {
-                await privacyStats.recordBlockedTracker(entityName)
-            }
+            privacyStats.countBlockedTracker(entityName)
         case .thirdPartyRequest:
             break
         }
@@ -169,6 +169,7 @@ final class WebViewContainerView: NSView {
 
                         let newWindow = type(of: window).init(contentRect: NSScreen.main?.frame ?? .zero, styleMask: window.styleMask, backing: .buffered, defer: false)
 
+                        // `page` is a C++ reference: it receives the placeholder object pointer (never NULL) and is restored below
                         fullScreenWindowController.perform(Selector.initWithWindowWebViewPage, withArguments: [newWindow, webView, NSValue(pointer: nil)])
                         fullScreenWindowController.setValue(pageRef, forKey: Key.page)
 
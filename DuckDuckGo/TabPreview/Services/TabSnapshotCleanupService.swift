@@ -17,27 +17,29 @@
 //
 
 import Foundation
+import os.log
 
 final class TabSnapshotCleanupService {
 
-    private let fileStore: FileStore
     private let store: TabSnapshotStore
 
     init(fileStore: FileStore) {
-        self.fileStore = fileStore
         self.store = TabSnapshotStore(fileStore: fileStore)
     }
 
     func cleanStoredSnapshots(except ids: Set<UUID>) async {
-        let tabSnapshotStore = TabSnapshotStore(fileStore: fileStore)
-
-        // Get all snapshot UUIDs stored in the snapshot directory
-        let storedSnapshotIds = Set(await tabSnapshotStore.loadAllStoredSnapshotIds())
+        await store.compact(keeping: ids)
+        removeLegacySnapshotsDirectory()
+    }
 
-        // Cleanup
-        let snapshotsToRemove = storedSnapshotIds.subtracting(ids)
-        snapshotsToRemove.forEach {
-            store.clearSnapshot(tabID: $0)
+    /// Snapshots used to be stored as separate files before the pack file was introduced.
+    private func removeLegacySnapshotsDirectory() {
+        let directoryURL = URL.persistenceLocation(for: TabSnapshotStore.directoryName)
+        guard FileManager.default.fileExists(atPath: directoryURL.path) else { return }
+        do {
+            try FileManager.default.removeItem(at: directoryURL)
+        } catch {
+            Logger.tabSnapshots.error("Failed to remove legacy snapshots directory: \(error.localizedDescription, privacy: .public)")
         }
     }
 
@@ -0,0 +1,262 @@
+//
+//  TabSnapshotPackFile.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import os.log
+
+/// Append-only file storing the tab snapshots, indexed by tab ID in memory.
+///
+/// Records are `[tab UUID: 16 bytes][payload length: UInt32 LE][payload]`, a zero length record removes the snapshot.
+/// Replaced and removed records stay in the file until it‘s compacted, but the payloads of a removed snapshot are zeroed
+/// right away, so the screenshots of closed or burned tabs don‘t stay on disk.
+/// The pack file is shared by all the `TabSnapshotStore` instances and should only be accessed on its `queue`.
+final class TabSnapshotPackFile {
+
+    struct Record: Equatable {
+        let offset: UInt64
+        let length: Int
+    }
+
+    private static let headerLength = 20
+    /// the pack file is compacted when a snapshot is removed once the garbage takes more than this many bytes
+    static let compactionThreshold: UInt64 = 16 * 1024 * 1024
+
+    private static var packFiles = [URL: TabSnapshotPackFile]()
+    private static let packFilesLock = NSLock()
+
+    /// Returns the shared instance for the pack file at `url`.
+    static func shared(at url: URL) -> TabSnapshotPackFile {
+        packFilesLock.withLock {
+            if let packFile = packFiles[url] {
+                return packFile
+            }
+            let packFile = TabSnapshotPackFile(url: url)
+            packFiles[url] = packFile
+            return packFile
+        }
+    }
+
+    let url: URL
+    let queue: DispatchQueue
+
+    private var _index: [UUID: Record]?
+    /// bytes taken by the replaced and removed records
+    private(set) var garbageByteCount: UInt64 = 0
+    /// records of the replaced snapshots, zeroed when their tab‘s snapshot is removed
+    private var replacedRecords = [UUID: [Record]]()
+
+    private init(url: URL) {
+        self.url = url
+        self.queue = DispatchQueue(label: "TabSnapshotPackFile.queue", qos: .utility)
+    }
+
+    var ids: [UUID] {
+        Array(index.keys)
+    }
+
+    func read(id: UUID) -> Data? {
+        dispatchPrecondition(condition: .onQueue(queue))
+        guard let record = index[id],
+              let fileHandle = try? FileHandle(forReadingFrom: url) else { return nil }
+        defer { try? fileHandle.close() }
+
+        do {
+            try fileHandle.seek(toOffset: record.offset + UInt64(Self.headerLength))
+            guard let data = try fileHandle.read(upToCount: record.length), data.count == record.length else { return nil }
+            return data
+        } catch {
+            Logger.tabSnapshots.error("TabSnapshotPackFile: Reading snapshot failed: \(error.localizedDescription)")
+            return nil
+        }
+    }
+
+    @discardableResult
+    func write(_ data: Data, id: UUID) -> Bool {
+        dispatchPrecondition(condition: .onQueue(queue))
+        assert(!data.isEmpty && data.count <= UInt32.max)
+
+        // the index is loaded before appending, so the new record isn‘t read as a replaced one
+        let replaced = index[id]
+        guard let offset = append(Self.header(id: id, length: data.count) + data) else { return false }
+        if let replaced {
+            garbageByteCount += UInt64(Self.headerLength + replaced.length)
+            replacedRecords[id, default: []].append(replaced)
+        }
+        index[id] = Record(offset: offset, length: data.count)
+        return true
+    }
+
+    @discardableResult
+    func remove(id: UUID) -> Bool {
+        dispatchPrecondition(condition: .onQueue(queue))
+        guard let removed = index[id] else { return true }
+
+        guard append(Self.header(id: id, length: 0)) != nil else { return false }
+        garbageByteCount += UInt64(2 * Self.headerLength + removed.length)
+        index[id] = nil
+
+        let erased = erase((replacedRecords.removeValue(forKey: id) ?? []) + [removed])
+        if garbageByteCount > Self.compactionThreshold {
+            return compact(keeping: Set(index.keys))
+        }
+        return erased
+    }
+
+    /// Rewrites the pack file with the snapshots of the `ids` only.
+    @discardableResult
+    func compact(keeping ids: Set<UUID>) -> Bool {
+        dispatchPrecondition(condition: .onQueue(queue))
+        let index = self.index
+        let idsToKeep = index.keys.filter(ids.contains)
+        guard idsToKeep.count < index.count || garbageByteCount > 0 else { return true }
+
+        let temporaryURL = url.appendingPathExtension("tmp")
+        var newIndex = [UUID: Record]()
+        do {
+            FileManager.default.createFile(atPath: temporaryURL.path, contents: nil)
+            let output = try FileHandle(forWritingTo: temporaryURL)
+            defer { try? output.close() }
+
+            var offset: UInt64 = 0
+            for id in idsToKeep {
+                guard let data = read(id: id) else { continue }
+                try output.write(contentsOf: Self.header(id: id, length: data.count) + data)
+                newIndex[id] = Record(offset: offset, length: data.count)
+                offset += UInt64(Self.headerLength + data.count)
+            }
+            try output.synchronize()
+            _ = try FileManager.default.replaceItemAt(url, withItemAt: temporaryURL)
+        } catch {
+            Logger.tabSnapshots.error("TabSnapshotPackFile: Compaction failed: \(error.localizedDescription)")
+            try? FileManager.default.removeItem(at: temporaryURL)
+            return false
+        }
+
+        self._index = newIndex
+        self.garbageByteCount = 0
+        self.replacedRecords = [:]
+        return true
+    }
+
+    /// Removes the pack file and forgets all the snapshots.
+    func removeAll() {
+        dispatchPrecondition(condition: .onQueue(queue))
+        try? FileManager.default.removeItem(at: url)
+        _index = [:]
+        garbageByteCount = 0
+        replacedRecords = [:]
+    }
+
+    // MARK: - Private
+
+    private var index: [UUID: Record] {
+        get {
+            if let index = _index {
+                return index
+            }
+            let index = loadIndex()
+            _index = index
+            return index
+        }
+        set {
+            _index = newValue
+        }
+    }
+
+    private static func header(id: UUID, length: Int) -> Data {
+        var header = Data(capacity: headerLength)
+        withUnsafeBytes(of: id.uuid) { header.append(contentsOf: $0) }
+        withUnsafeBytes(of: UInt32(length).littleEndian) { header.append(contentsOf: $0) }
+        return header
+    }
+
+    /// Reads the record headers, skipping the payloads.
+    private func loadIndex() -> [UUID: Record] {
+        guard let fileHandle = try? FileHandle(forUpdating: url) else { return [:] }
+        defer { try? fileHandle.close() }
+
+        var index = [UUID: Record]()
+        var offset: UInt64 = 0
+        do {
+            let fileSize = try fileHandle.seekToEnd()
+            while offset + UInt64(Self.headerLength) <= fileSize {
+                try fileHandle.seek(toOffset: offset)
+                guard let header = try fileHandle.read(upToCount: Self.headerLength), header.count == Self.headerLength else { break }
+
+                let id = header.withUnsafeBytes { NSUUID(uuidBytes: $0.baseAddress!.assumingMemoryBound(to: UInt8.self)) as UUID }
+                let length = Int(UInt32(littleEndian: header.subdata(in: 16..<20).withUnsafeBytes { $0.load(as: UInt32.self) }))
+                guard offset + UInt64(Self.headerLength + length) <= fileSize else { break }
+
+                if let replaced = index[id] {
+                    garbageByteCount += UInt64(Self.headerLength + replaced.length)
+                    replacedRecords[id, default: []].append(replaced)
+                }
+                if length > 0 {
+                    index[id] = Record(offset: offset, length: length)
+                } else {
+                    garbageByteCount += UInt64(Self.headerLength)
+                    index[id] = nil
+                    replacedRecords[id] = nil
+                }
+                offset += UInt64(Self.headerLength + length)
+            }
+            if offset < fileSize {
+                // drop a partially written record
+                try fileHandle.truncate(atOffset: offset)
+            }
+        } catch {
+            Logger.tabSnapshots.error("TabSnapshotPackFile: Reading index failed: \(error.localizedDescription)")
+        }
+        return index
+    }
+
+    /// Overwrites the payloads of the records with zeros, keeping their headers so the index can still be read.
+    private func erase(_ records: [Record]) -> Bool {
+        do {
+            let fileHandle = try FileHandle(forWritingTo: url)
+            defer { try? fileHandle.close() }
+            for record in records {
+                try fileHandle.seek(toOffset: record.offset + UInt64(Self.headerLength))
+                try fileHandle.write(contentsOf: Data(count: record.length))
+            }
+            try fileHandle.synchronize()
+            return true
+        } catch {
+            Logger.tabSnapshots.error("TabSnapshotPackFile: Erasing snapshot failed: \(error.localizedDescription)")
+            return false
+        }
+    }
+
+    /// - Returns: offset of the appended data
+    private func append(_ data: Data) -> UInt64? {
+        if !FileManager.default.fileExists(atPath: url.path) {
+            FileManager.default.createFile(atPath: url.path, contents: nil)
+        }
+        do {
+            let fileHandle = try FileHandle(forWritingTo: url)
+            defer { try? fileHandle.close() }
+            let offset = try fileHandle.seekToEnd()
+            try fileHandle.write(contentsOf: data)
+            return offset
+        } catch {
+            Logger.tabSnapshots.error("TabSnapshotPackFile: Writing snapshot failed: \(error.localizedDescription)")
+            return nil
+        }
+    }
+
+}
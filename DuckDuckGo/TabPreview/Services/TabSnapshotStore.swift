@@ -16,9 +16,11 @@
 //  limitations under the License.
 //
 
+import Accelerate
 import Cocoa
 import Common
 import os.log
+import UniformTypeIdentifiers
 
 protocol TabSnapshotStoring {
 
@@ -31,24 +33,41 @@ protocol TabSnapshotStoring {
 
 final class TabSnapshotStore: TabSnapshotStoring {
 
+    /// directory of the snapshot files stored before the pack file was introduced
     static let directoryName: String = "tabSnapshots"
+    static let packFileName: String = "tabSnapshots.pack"
+
+    private enum Constants {
+        /// snapshots are stored at the preview size on a Retina display
+        static let maxPixelWidth = Int(TabPreviewWindowController.width * 2)
+        static let cacheByteBudget = 64 * 1024 * 1024
+    }
+
+    /// decoded snapshots shared by the store instances, limited by the bitmap byte size
+    private static let cache: NSCache<NSUUID, NSImage> = {
+        let cache = NSCache<NSUUID, NSImage>()
+        cache.totalCostLimit = Constants.cacheByteBudget
+        return cache
+    }()
 
     private let fileStore: FileStore
+    private let packFile: TabSnapshotPackFile
 
-    init(fileStore: FileStore) {
+    init(fileStore: FileStore, packFileURL: URL = URL.persistenceLocation(for: TabSnapshotStore.packFileName)) {
         self.fileStore = fileStore
+        self.packFile = TabSnapshotPackFile.shared(at: packFileURL)
     }
 
     func persistSnapshot(_ snapshot: NSImage, id: UUID) {
-        guard let data = snapshot.tiffRepresentation else {
-            Logger.tabSnapshots.error("TabSnapshotPersistenceService: Failed to create tiff representation")
+        guard let image = snapshot.cgImage(forProposedRect: nil, context: nil, hints: nil) else {
+            Logger.tabSnapshots.error("TabSnapshotPersistenceService: Failed to create image representation")
             return
         }
+        Self.cache.setObject(snapshot, forKey: id as NSUUID, cost: image.bytesPerRow * image.height)
 
-        Task {
-            let url = URL.persistenceLocation(for: id)
-            createDirectoryIfNeeded()
-            guard fileStore.persist(data, url: url) else {
+        packFile.queue.async { [fileStore, packFile] in
+            guard let data = Self.encode(image, maxPixelWidth: Constants.maxPixelWidth).flatMap(fileStore.encrypt),
+                  packFile.write(data, id: id) else {
                 Logger.tabSnapshots.error("TabSnapshotPersistenceService: Saving of snapshot failed")
                 return
             }
@@ -56,65 +75,87 @@ final class TabSnapshotStore: TabSnapshotStoring {
     }
 
     func clearSnapshot(tabID: UUID) {
-        Task {
-            let url = URL.persistenceLocation(for: tabID)
-            fileStore.remove(fileAtURL: url)
+        Self.cache.removeObject(forKey: tabID as NSUUID)
+        packFile.queue.async { [packFile] in
+            packFile.remove(id: tabID)
         }
     }
 
     func loadSnapshot(for tabID: UUID) async -> NSImageSendable? {
-        let url = URL.persistenceLocation(for: tabID)
-
-        if let data = fileStore.loadData(at: url),
-           let image = NSImage(data: data) {
+        if let image = Self.cache.object(forKey: tabID as NSUUID) {
             return image as NSImageSendable
-        } else {
+        }
+
+        let image: CGImage? = await withCheckedContinuation { continuation in
+            packFile.queue.async { [fileStore, packFile] in
+                let image = packFile.read(id: tabID).flatMap(fileStore.decrypt).flatMap(Self.decode)
+                continuation.resume(returning: image)
+            }
+        }
+        guard let image else {
             Logger.tabSnapshots.error("TabSnapshotPersistenceService: Loading of snapshot failed")
             return nil
         }
-    }
 
-    private func createDirectoryIfNeeded() {
-        let directoryURL = URL.persistenceLocation(for: Self.directoryName)
+        let width = TabPreviewWindowController.width
+        let snapshot = NSImage(cgImage: image, size: NSSize(width: width, height: width * CGFloat(image.height) / CGFloat(image.width)))
+        Self.cache.setObject(snapshot, forKey: tabID as NSUUID, cost: image.bytesPerRow * image.height)
+        return snapshot as NSImageSendable
+    }
 
-        if !FileManager.default.fileExists(atPath: directoryURL.path) {
-            do {
-                try FileManager.default.createDirectory(at: directoryURL,
-                                                        withIntermediateDirectories: true,
-                                                        attributes: nil)
-            } catch {
-                fatalError("Failed to create directory at \(directoryURL.path)")
+    func loadAllStoredSnapshotIds() async -> [UUID] {
+        await withCheckedContinuation { continuation in
+            packFile.queue.async { [packFile] in
+                continuation.resume(returning: packFile.ids)
             }
         }
     }
 
-    func loadAllStoredSnapshotIds() async -> [UUID] {
-        var uuids: [UUID] = []
-
-        let directoryURL = URL.persistenceLocation(for: Self.directoryName)
-        do {
-            let fileURLs = try FileManager.default.contentsOfDirectory(at: directoryURL, includingPropertiesForKeys: nil)
-            for fileURL in fileURLs {
-                guard let uuid = UUID(uuidString: fileURL.deletingPathExtension().lastPathComponent) else {
-                    continue
-                }
-
-                uuids.append(uuid)
+    /// Removes the snapshots of the tabs other than `ids` and compacts the pack file.
+    func compact(keeping ids: Set<UUID>) async {
+        await withCheckedContinuation { continuation in
+            packFile.queue.async { [packFile] in
+                packFile.compact(keeping: ids)
+                continuation.resume()
             }
-        } catch {
-            Logger.tabSnapshots.error("Failed to load stored snapshot ids: \(error.localizedDescription, privacy: .public)")
         }
-
-        return uuids
     }
 
-}
+    // MARK: - Encoding
+
+    /// Encodes the snapshot as PNG, downscaling it to `maxPixelWidth` if needed.
+    static func encode(_ image: CGImage, maxPixelWidth: Int) -> Data? {
+        let image = image.width > maxPixelWidth ? downscale(image, toWidth: maxPixelWidth) ?? image : image
 
-fileprivate extension URL {
+        let data = NSMutableData()
+        guard let destination = CGImageDestinationCreateWithData(data, UTType.png.identifier as CFString, 1, nil) else { return nil }
+        CGImageDestinationAddImage(destination, image, nil)
+        guard CGImageDestinationFinalize(destination) else { return nil }
+        return data as Data
+    }
+
+    /// Decodes the snapshot bitmap immediately so it‘s not decoded again when drawn.
+    static func decode(_ data: Data) -> CGImage? {
+        guard let source = CGImageSourceCreateWithData(data as CFData, nil) else { return nil }
+        return CGImageSourceCreateImageAtIndex(source, 0, [kCGImageSourceShouldCacheImmediately: true] as CFDictionary)
+    }
 
-    static func persistenceLocation(for id: UUID) -> URL {
-        let fileName = "\(TabSnapshotStore.directoryName)/\(id.uuidString)"
-        return URL.persistenceLocation(for: fileName)
+    /// Vectorized (vImage) downscaling.
+    private static func downscale(_ image: CGImage, toWidth width: Int) -> CGImage? {
+        guard var format = vImage_CGImageFormat(bitsPerComponent: 8,
+                                                bitsPerPixel: 32,
+                                                colorSpace: image.colorSpace ?? CGColorSpaceCreateDeviceRGB(),
+                                                bitmapInfo: CGBitmapInfo(rawValue: CGImageAlphaInfo.premultipliedFirst.rawValue),
+                                                renderingIntent: .defaultIntent),
+              var source = try? vImage_Buffer(cgImage: image, format: format) else { return nil }
+        defer { source.free() }
+
+        let height = max(1, Int((CGFloat(image.height) * CGFloat(width) / CGFloat(image.width)).rounded()))
+        guard var destination = try? vImage_Buffer(width: width, height: height, bitsPerPixel: format.bitsPerPixel) else { return nil }
+        defer { destination.free() }
+
+        guard vImageScale_ARGB8888(&source, &destination, nil, vImage_Flags(kvImageHighQualityResampling)) == kvImageNoError else { return nil }
+        return try? destination.createCGImage(format: format)
     }
 
 }
@@ -26,19 +26,31 @@ import Combine
 /// of all embedded binaries.  This is useful because when blocking or excluding an app the user
 /// likely expects the rule to extend to all child processes.
 ///
+/// The expanded rules and the excluded domains are compiled into a ``VPNRoutingRuleMatcher``, which is
+/// rebuilt off the main thread when the settings change and swapped in without blocking the flows being matched.
+///
 final class AppRoutingRulesManager {
 
     private let appInfoRetriever: AppInfoRetrieving
-    private(set) var rules: VPNAppRoutingRules
+    private let rulesQueue = DispatchQueue(label: "com.duckduckgo.network-protection.app-routing-rules", qos: .utility)
+    private let lock = NSLock()
+    private var _matcher: VPNRoutingRuleMatcher
     private var cancellables = Set<AnyCancellable>()
 
+    /// The current routing rules.
+    var matcher: VPNRoutingRuleMatcher {
+        lock.withLock { _matcher }
+    }
+
     init(settings: TransparentProxySettings,
          appInfoRetriever: AppInfoRetrieving = AppInfoRetriever()) {
 
         self.appInfoRetriever = appInfoRetriever
-        self.rules = Self.expandAppRoutingRules(settings.appRoutingRules, appInfoRetriever: appInfoRetriever)
+        self._matcher = VPNRoutingRuleMatcher(
+            appRoutingRules: Self.expandAppRoutingRules(settings.appRoutingRules, appInfoRetriever: appInfoRetriever),
+            excludedDomains: settings.excludedDomains)
 
-        subscribeToAppRoutingRulesChanges(settings)
+        subscribeToRoutingRulesChanges(settings)
     }
 
     static func expandAppRoutingRules(_ rules: VPNAppRoutingRules,
@@ -61,13 +73,21 @@ final class AppRoutingRulesManager {
         return expandedRules
     }
 
-    private func subscribeToAppRoutingRulesChanges(_ settings: TransparentProxySettings) {
+    private func subscribeToRoutingRulesChanges(_ settings: TransparentProxySettings) {
         settings.appRoutingRulesPublisher
-            .receive(on: DispatchQueue.main)
-            .map { [appInfoRetriever] rules in
-                return Self.expandAppRoutingRules(rules, appInfoRetriever: appInfoRetriever)
+            .combineLatest(settings.excludedDomainsPublisher)
+            .dropFirst()
+            .receive(on: rulesQueue)
+            .map { [appInfoRetriever] rules, excludedDomains in
+                VPNRoutingRuleMatcher(appRoutingRules: Self.expandAppRoutingRules(rules, appInfoRetriever: appInfoRetriever),
+                                      excludedDomains: excludedDomains)
+            }
+            .sink { [weak self] matcher in
+                guard let self else { return }
+                lock.withLock {
+                    self._matcher = matcher
+                }
             }
-            .assign(to: \.rules, onWeaklyHeld: self)
             .store(in: &cancellables)
     }
 }
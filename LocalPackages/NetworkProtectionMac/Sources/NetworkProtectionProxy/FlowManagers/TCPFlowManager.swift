@@ -142,37 +142,40 @@ final class TCPFlowManager {
     }
 
     private func startDataCopyLoop(for remoteConnection: NWConnection) async throws {
+        let outboundRelay = makeOutboundRelay(to: remoteConnection)
+        let inboundRelay = makeInboundRelay(from: remoteConnection)
+
+        defer {
+            logger.log("Relayed \(outboundRelay.byteCount, privacy: .public) bytes out, \(inboundRelay.byteCount, privacy: .public) bytes in")
+        }
+
         try await withThrowingTaskGroup(of: Void.self) { group in
-            group.addTask { [weak self] in
-                while true {
-                    guard let self else {
-                        throw RemoteConnectionError.cancelled
-                    }
-
-                    try Task.checkCancellation()
-                    try await self.copyOutboundTraffic(to: remoteConnection)
-                }
+            group.addTask { [flow] in
+                try await outboundRelay.run()
+                // half-close: the remote side gets the end of the stream, but can still send data
+                try await Self.sendEndOfStream(to: remoteConnection)
+                flow.closeReadWithError(nil)
             }
 
-            group.addTask { [weak self] in
-                while true {
-                    guard let self else {
-                        throw RemoteConnectionError.cancelled
-                    }
-
-                    try Task.checkCancellation()
-                    try await self.copyInboundTraffic(from: remoteConnection)
-                }
+            group.addTask { [flow] in
+                try await inboundRelay.run()
+                // half-close: the app gets the end of the stream, but can still send data
+                flow.closeWriteWithError(nil)
             }
 
+            // Each direction is closed on its own once it reaches the end of the stream,
+            // the flow is done when both are
             while !group.isEmpty {
-                 do {
-                     try await group.next()
-
-                 } catch {
-                     group.cancelAll()
-                     throw error
-                 }
+                do {
+                    try await group.next()
+                } catch {
+                    // Fail any pending reads and writes so the other direction stops too
+                    remoteConnection.cancel()
+                    flow.closeReadWithError(error)
+                    flow.closeWriteWithError(error)
+                    group.cancelAll()
+                    throw error
+                }
             }
         }
     }
@@ -184,67 +187,65 @@ final class TCPFlowManager {
         flow.closeWriteWithError(error)
     }
 
-    static let maxReceiveSize: Int = Int(Measurement(value: 2, unit: UnitInformationStorage.megabytes).converted(to: .bytes).value)
+    /// Largest chunk received from the remote connection, buffered on top of `TCPFlowRelay.defaultMaxBytesInFlight`.
+    ///
+    static let maxReceiveSize: Int = Int(Measurement(value: 256, unit: UnitInformationStorage.kilobytes).converted(to: .bytes).value)
+
+    /// Relays the data received from the remote connection to the flow.
+    ///
+    private func makeInboundRelay(from remoteConnection: NWConnection) -> TCPFlowRelay {
+        TCPFlowRelay { completion in
+            remoteConnection.receive(minimumIncompleteLength: 1, maximumLength: Self.maxReceiveSize) { data, _, _, error in
+                switch (data, error) {
+                case (.some(let data), _) where !data.isEmpty:
+                    completion(.success(data))
+                case (_, .some(let error)):
+                    completion(.failure(RemoteConnectionError.unhandledError(error)))
+                default:
+                    completion(.success(nil))
+                }
+            }
+        } write: { [weak flow] data, completion in
+            guard let flow else {
+                completion(RemoteConnectionError.cancelled)
+                return
+            }
+            flow.write(data, withCompletionHandler: completion)
+        }
+    }
 
-    func copyInboundTraffic(from remoteConnection: NWConnection) async throws {
-        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-            Task { @TCPFlowActor in
-                remoteConnection.receive(minimumIncompleteLength: 1,
-                                         maximumLength: Self.maxReceiveSize) { [weak flow] (data, _, isComplete, error) in
-                    guard let flow else {
-                        continuation.resume(throwing: RemoteConnectionError.cancelled)
-                        return
-                    }
-
-                    switch (data, isComplete, error) {
-                    case (.some(let data), _, _) where !data.isEmpty:
-                        flow.write(data) { writeError in
-                            if let writeError {
-                                continuation.resume(throwing: writeError)
-                                remoteConnection.cancel()
-                            } else {
-                                continuation.resume()
-                            }
-                        }
-                    case (_, isComplete, _) where isComplete == true:
-                        continuation.resume(throwing: RemoteConnectionError.complete)
-                        remoteConnection.cancel()
-                    case (_, _, .some(let error)):
-                        continuation.resume(throwing: RemoteConnectionError.unhandledError(error))
-                        remoteConnection.cancel()
-                    default:
-                        continuation.resume(throwing: RemoteConnectionError.complete)
-                        remoteConnection.cancel()
-                    }
+    /// Relays the data read from the flow to the remote connection.
+    ///
+    private func makeOutboundRelay(to remoteConnection: NWConnection) -> TCPFlowRelay {
+        TCPFlowRelay { [weak flow] completion in
+            guard let flow else {
+                completion(.failure(RemoteConnectionError.cancelled))
+                return
+            }
+            flow.readData { data, error in
+                switch (data, error) {
+                case (.some(let data), _) where !data.isEmpty:
+                    completion(.success(data))
+                case (_, .some(let error)):
+                    completion(.failure(error))
+                default:
+                    completion(.success(nil))
                 }
             }
+        } write: { data, completion in
+            remoteConnection.send(content: data, completion: .contentProcessed(completion))
         }
     }
 
-    func copyOutboundTraffic(to remoteConnection: NWConnection) async throws {
+    private static func sendEndOfStream(to remoteConnection: NWConnection) async throws {
         try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-            Task { @TCPFlowActor in
-                flow.readData { data, error in
-                    switch (data, error) {
-                    case (.some(let data), _) where !data.isEmpty:
-                        remoteConnection.send(content: data, completion: .contentProcessed({ error in
-                            if let error {
-                                continuation.resume(throwing: error)
-                                remoteConnection.cancel()
-                                return
-                            }
-
-                            continuation.resume()
-                        }))
-                    case (_, .some(let error)):
-                        continuation.resume(throwing: error)
-                        remoteConnection.cancel()
-                    default:
-                        continuation.resume(throwing: RemoteConnectionError.complete)
-                        remoteConnection.cancel()
-                    }
+            remoteConnection.send(content: nil, contentContext: .finalMessage, isComplete: true, completion: .contentProcessed({ error in
+                if let error {
+                    continuation.resume(throwing: error)
+                } else {
+                    continuation.resume()
                 }
-            }
+            }))
         }
     }
 }
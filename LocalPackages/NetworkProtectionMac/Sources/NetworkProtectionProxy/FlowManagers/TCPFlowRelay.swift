@@ -0,0 +1,156 @@
+//
+//  TCPFlowRelay.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Relays one direction of a TCP flow, from a reader to a writer.
+///
+/// The next chunk is read while the previous ones are still being written, instead of waiting for each write
+/// to complete. No new chunk is read once `maxBytesInFlight` bytes have been read but not yet written, so a slow
+/// writer slows down the reader. Reads and writes are chained through their completion handlers, without a task per chunk.
+///
+/// Memory: a relay buffers up to `maxBytesInFlight` bytes plus one read chunk.  The proxy runs two relays per TCP flow
+/// in a system extension handling every proxied flow at once, so the default budget is kept small.
+///
+final class TCPFlowRelay {
+
+    /// Reads the next chunk, calling the completion handler with `nil` at the end of the stream.
+    typealias Read = (_ completion: @escaping (Result<Data?, Error>) -> Void) -> Void
+    typealias Write = (_ data: Data, _ completion: @escaping (Error?) -> Void) -> Void
+
+    static let defaultMaxBytesInFlight: Int = Int(Measurement(value: 512, unit: UnitInformationStorage.kilobytes).converted(to: .bytes).value)
+
+    private let read: Read
+    private let write: Write
+    private let maxBytesInFlight: Int
+
+    private let lock = NSLock()
+    private var bytesInFlight = 0
+    private var isReading = false
+    private var didReachEnd = false
+    private var completion: ((Error?) -> Void)?
+    private var _byteCount: Int64 = 0
+
+    /// Number of bytes relayed so far.
+    var byteCount: Int64 {
+        lock.withLock { _byteCount }
+    }
+
+    init(maxBytesInFlight: Int = TCPFlowRelay.defaultMaxBytesInFlight, read: @escaping Read, write: @escaping Write) {
+        self.maxBytesInFlight = maxBytesInFlight
+        self.read = read
+        self.write = write
+    }
+
+    /// Relays the data until the end of the stream has been read and written.
+    ///
+    /// Throws the first read or write error.
+    ///
+    func run() async throws {
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+            lock.withLock {
+                completion = { error in
+                    if let error {
+                        continuation.resume(throwing: error)
+                    } else {
+                        continuation.resume()
+                    }
+                }
+                isReading = true
+            }
+            readNext()
+        }
+    }
+
+    // MARK: - Private
+
+    private func readNext() {
+        read { [self] result in
+            switch result {
+            case .success(let data?) where !data.isEmpty:
+                let shouldReadNext = lock.withLock {
+                    bytesInFlight += data.count
+                    _byteCount += Int64(data.count)
+                    isReading = bytesInFlight < maxBytesInFlight && completion != nil
+                    return isReading
+                }
+
+                write(data) { [self] error in
+                    didWrite(byteCount: data.count, error: error)
+                }
+
+                if shouldReadNext {
+                    readNext()
+                }
+            case .success:
+                let isFinished = lock.withLock {
+                    isReading = false
+                    didReachEnd = true
+                    return bytesInFlight == 0
+                }
+                if isFinished {
+                    finish(with: nil)
+                }
+            case .failure(let error):
+                finish(with: error)
+            }
+        }
+    }
+
+    private func didWrite(byteCount: Int, error: Error?) {
+        if let error {
+            finish(with: error)
+            return
+        }
+
+        enum NextStep {
+            case none
+            case read
+            case finish
+        }
+        let nextStep: NextStep = lock.withLock {
+            bytesInFlight -= byteCount
+            if didReachEnd {
+                return bytesInFlight == 0 ? .finish : .none
+            }
+            // resume reading once the writer caught up
+            guard !isReading, bytesInFlight < maxBytesInFlight, completion != nil else { return .none }
+            isReading = true
+            return .read
+        }
+
+        switch nextStep {
+        case .none:
+            break
+        case .read:
+            readNext()
+        case .finish:
+            finish(with: nil)
+        }
+    }
+
+    private func finish(with error: Error?) {
+        let completion = lock.withLock {
+            let completion = self.completion
+            self.completion = nil
+            return completion
+        }
+        completion?(error)
+    }
+
+}
@@ -38,9 +38,13 @@ struct UDPFlowActor {
 final class UDPConnectionManager {
     let endpoint: NWEndpoint
     private let connection: NWConnection
-    private let onReceive: (_ endpoint: NWEndpoint, _ result: Result<Data, Error>) async -> Void
+    private let onReceive: (_ endpoint: NWEndpoint, _ result: Result<Data, Error>) -> Void
 
-    init(endpoint: NWHostEndpoint, interface: NWInterface?, onReceive: @UDPFlowActor @escaping (_ endpoint: NWEndpoint, _ result: Result<Data, Error>) async -> Void) {
+    /// - Parameters:
+    ///     - onReceive: called with each received datagram.  It must not wait for the datagram to be processed, so the
+    ///         next one is received right away.
+    ///
+    init(endpoint: NWHostEndpoint, interface: NWInterface?, onReceive: @UDPFlowActor @escaping (_ endpoint: NWEndpoint, _ result: Result<Data, Error>) -> Void) {
         let host = Network.NWEndpoint.Host(endpoint.hostname)
         let port = Network.NWEndpoint.Port(endpoint.port)!
 
@@ -79,10 +83,10 @@ final class UDPConnectionManager {
             while true {
                 do {
                     let datagram = try await receive()
-                    await onReceive(endpoint, .success(datagram))
+                    onReceive(endpoint, .success(datagram))
                 } catch {
                     connection.cancel()
-                    await onReceive(endpoint, .failure(error))
+                    onReceive(endpoint, .failure(error))
                     break
                 }
             }
@@ -151,18 +155,43 @@ final class UDPConnectionManager {
 
     // MARK: - Writing datagrams
 
-    func write(datagram: Data) async throws {
+    /// Sends the datagrams in a single batch.
+    ///
+    /// Waits for all the datagrams to be processed, and throws the first send error if any.
+    ///
+    func write(datagrams: [Data]) async throws {
+        guard !datagrams.isEmpty else { return }
+
         try await start()
 
         try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-            connection.send(content: datagram, completion: .contentProcessed({ error in
-                if let error {
+            // Send completions are called on the connection's (concurrent) queue
+            let lock = NSLock()
+            let group = DispatchGroup()
+            var sendError: Error?
+
+            connection.batch {
+                for datagram in datagrams {
+                    group.enter()
+                    connection.send(content: datagram, completion: .contentProcessed({ error in
+                        if let error {
+                            lock.withLock {
+                                sendError = sendError ?? error
+                            }
+                        }
+                        group.leave()
+                    }))
+                }
+            }
+
+            group.notify(queue: .global()) {
+                if let error = lock.withLock({ sendError }) {
                     continuation.resume(throwing: error)
                     return
                 }
 
                 continuation.resume()
-            }))
+            }
         }
     }
 }
@@ -200,6 +229,18 @@ final class UDPFlowManager {
 
     private var connectionManagers = [NWEndpoint: UDPConnectionManager]()
 
+    /// Maximum number of datagrams received from the remote endpoints waiting to be written to the flow.
+    ///
+    /// If the app doesn't read them fast enough, further datagrams are dropped, as a full socket buffer would do.
+    ///
+    private static let maxPendingInboundDatagrams = 512
+
+    /// Datagrams received from the remote endpoints, written to the flow by a separate drain task so that receiving
+    /// never waits for the flow, and datagrams received during a write are written together by the next one.
+    ///
+    private var pendingInboundDatagrams = [(datagram: Data, endpoint: NWEndpoint)]()
+    private var isWritingInboundDatagrams = false
+
     init(flow: NEAppProxyUDPFlow) {
         self.flow = flow
     }
@@ -228,12 +269,42 @@ final class UDPFlowManager {
         }
     }
 
-    func copyInboundTraffic(endpoint: NWEndpoint, result: Result<Data, Error>) async {
+    func copyInboundTraffic(endpoint: NWEndpoint, result: Result<Data, Error>) {
         switch result {
         case .success(let data):
+            guard pendingInboundDatagrams.count < Self.maxPendingInboundDatagrams else {
+                return
+            }
+
+            pendingInboundDatagrams.append((data, endpoint))
+
+            // Datagrams received while a write is in progress are written together in the next batch
+            guard !isWritingInboundDatagrams else {
+                return
+            }
+
+            isWritingInboundDatagrams = true
+            Task {
+                await writePendingInboundDatagrams()
+            }
+        case .failure:
+            // Any failure means we close the connection
+            connectionManagers.removeValue(forKey: endpoint)
+        }
+    }
+
+    /// Drains the pending inbound datagrams.  `isWritingInboundDatagrams` is set by the caller when starting the drain task.
+    ///
+    private func writePendingInboundDatagrams() async {
+        defer { isWritingInboundDatagrams = false }
+
+        while !pendingInboundDatagrams.isEmpty {
+            let batch = pendingInboundDatagrams
+            pendingInboundDatagrams.removeAll(keepingCapacity: true)
+
             do {
                 try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-                    flow.writeDatagrams([data], sentBy: [endpoint]) { error in
+                    flow.writeDatagrams(batch.map(\.datagram), sentBy: batch.map(\.endpoint)) { error in
                         if let error {
                             continuation.resume(throwing: error)
                             return
@@ -243,12 +314,11 @@ final class UDPFlowManager {
                     }
                 }
             } catch {
-                // Any failure means we close the connection
-                connectionManagers.removeValue(forKey: endpoint)
+                // Any failure means we close the connections
+                for (_, endpoint) in batch {
+                    connectionManagers.removeValue(forKey: endpoint)
+                }
             }
-        case .failure:
-            // Any failure means we close the connection
-            connectionManagers.removeValue(forKey: endpoint)
         }
     }
 
@@ -260,12 +330,25 @@ final class UDPFlowManager {
             throw NEAppProxyFlowError(.aborted)
         }
 
+        // Datagrams are sent in one batch per endpoint, keeping their order
+        var batches = [(endpoint: NWHostEndpoint, datagrams: [Data])]()
+        var batchIndices = [NWHostEndpoint: Int]()
+
         for (datagram, endpoint) in zip(datagrams, endpoints) {
             guard let endpoint = endpoint as? NWHostEndpoint else {
                 // Not sure what to do about this...
                 continue
             }
 
+            if let index = batchIndices[endpoint] {
+                batches[index].datagrams.append(datagram)
+            } else {
+                batchIndices[endpoint] = batches.count
+                batches.append((endpoint, [datagram]))
+            }
+        }
+
+        for (endpoint, datagrams) in batches {
             let manager = connectionManagers[endpoint] ?? {
                 let manager = UDPConnectionManager(endpoint: endpoint, interface: interface, onReceive: copyInboundTraffic)
                 connectionManagers[endpoint] = manager
@@ -273,7 +356,7 @@ final class UDPFlowManager {
             }()
 
             do {
-                try await manager.write(datagram: datagram)
+                try await manager.write(datagrams: datagrams)
             } catch {
                 // Any failure means we close the connection
                 connectionManagers.removeValue(forKey: endpoint)
@@ -193,7 +193,8 @@ open class TransparentProxyProvider: NETransparentProxyProvider {
             NENetworkRule(remoteNetwork: nil, remotePrefix: 0, localNetwork: nil, localPrefix: 0, protocol: .UDP, direction: .outbound)
         ]
 
-        if isExcludedDomain("duckduckgo.com") {
+        // read the settings directly, the rules manager may not have picked up the change triggering this update yet
+        if settings.excludedDomains.contains(where: { "duckduckgo.com".hasSuffix($0) }) {
             networkSettings.includedNetworkRules?.append(
                 NENetworkRule(destinationHost: NWHostEndpoint(hostname: "duckduckgo.com", port: "443"), protocol: .any))
         }
@@ -448,11 +449,12 @@ open class TransparentProxyProvider: NETransparentProxyProvider {
 
     private func path(for flow: NEAppProxyFlow) -> FlowPath {
         let appIdentifier = flow.metaData.sourceAppSigningIdentifier
+        let matcher = appRoutingRulesManager.matcher
 
-        switch appRoutingRulesManager.rules[appIdentifier] {
+        switch matcher.rule(forAppIdentifier: appIdentifier) {
         case .none:
             if let hostname = flow.remoteHostname,
-               isExcludedDomain(hostname) {
+               matcher.isExcludedDomain(hostname) {
                 return .excludeFromVPN(dueTo: .domainRule)
             }
 
@@ -464,12 +466,6 @@ open class TransparentProxyProvider: NETransparentProxyProvider {
         }
     }
 
-    private func isExcludedDomain(_ hostname: String) -> Bool {
-        settings.excludedDomains.contains { excludedDomain in
-            hostname.hasSuffix(excludedDomain)
-        }
-    }
-
     // MARK: - Communication with App
 
     override public func handleAppMessage(_ messageData: Data) async -> Data? {
@@ -0,0 +1,95 @@
+//
+//  VPNRoutingRuleMatcher.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Routing rules compiled for the flow decisions.
+///
+/// The matcher is immutable: it's built once per settings change, so every new flow is matched
+/// without reading the settings, and flows being handled keep the matcher they started with.
+///
+struct VPNRoutingRuleMatcher {
+
+    private let appRoutingRules: VPNAppRoutingRules
+    private let excludedDomains: ReversedSuffixTrie
+
+    init(appRoutingRules: VPNAppRoutingRules = [:], excludedDomains: [String] = []) {
+        self.appRoutingRules = appRoutingRules
+        self.excludedDomains = ReversedSuffixTrie(suffixes: excludedDomains)
+    }
+
+    func rule(forAppIdentifier appIdentifier: String) -> VPNRoutingRule? {
+        appRoutingRules[appIdentifier]
+    }
+
+    /// Whether the hostname ends with any of the excluded domains.
+    ///
+    /// Takes time proportional to the hostname length, regardless of the number of excluded domains.
+    ///
+    func isExcludedDomain(_ hostname: String) -> Bool {
+        excludedDomains.containsSuffix(of: hostname)
+    }
+}
+
+/// Trie of strings inserted back to front, matching any string that ends with one of them.
+///
+private struct ReversedSuffixTrie {
+
+    private struct Node {
+        var children = [UInt8: Int]()
+        var isSuffixEnd = false
+    }
+
+    /// Nodes are stored in a single array and refer to their children by index, the root is the first one.
+    private var nodes = [Node()]
+
+    init(suffixes: [String]) {
+        for suffix in suffixes {
+            var index = 0
+            for byte in suffix.utf8.reversed() {
+                if let child = nodes[index].children[byte] {
+                    index = child
+                } else {
+                    nodes.append(Node())
+                    nodes[index].children[byte] = nodes.count - 1
+                    index = nodes.count - 1
+                }
+            }
+            nodes[index].isSuffixEnd = true
+        }
+    }
+
+    func containsSuffix(of string: String) -> Bool {
+        var index = 0
+        if nodes[index].isSuffixEnd {
+            return true
+        }
+
+        for byte in string.utf8.reversed() {
+            guard let child = nodes[index].children[byte] else {
+                return false
+            }
+            if nodes[child].isSuffixEnd {
+                return true
+            }
+            index = child
+        }
+
+        return false
+    }
+}
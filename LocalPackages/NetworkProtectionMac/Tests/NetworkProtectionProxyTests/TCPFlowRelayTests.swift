@@ -0,0 +1,227 @@
+//
+//  TCPFlowRelayTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+@testable import NetworkProtectionProxy
+import XCTest
+
+private struct RelayTestError: Error, Equatable {
+    let id: Int
+}
+
+/// Serves the chunks to the relay and keeps its writes pending until they're completed by the test.
+///
+private final class RelayEndpoints {
+
+    private let lock = NSLock()
+    private var chunks: [Data]
+    private var pendingWrites = [(data: Data, completion: (Error?) -> Void)]()
+    private var _readCount = 0
+    private var _writtenData = [Data]()
+
+    /// Completes the writes right away on a serial queue instead of keeping them pending.
+    var completesWritesAutomatically = false
+    /// Called with the number of pending writes when the relay writes a chunk.
+    var onWrite: ((Int) -> Void)?
+    /// Called when the relay reads the end of the stream.
+    var onEndOfStream: (() -> Void)?
+
+    private let writeQueue = DispatchQueue(label: "com.duckduckgo.TCPFlowRelayTests.write")
+
+    init(chunks: [Data]) {
+        self.chunks = chunks
+    }
+
+    var readCount: Int {
+        lock.withLock { _readCount }
+    }
+
+    var writtenData: [Data] {
+        lock.withLock { _writtenData }
+    }
+
+    var pendingWriteCount: Int {
+        lock.withLock { pendingWrites.count }
+    }
+
+    func makeRelay(maxBytesInFlight: Int) -> TCPFlowRelay {
+        TCPFlowRelay(maxBytesInFlight: maxBytesInFlight) { [self] completion in
+            let chunk: Data? = lock.withLock {
+                _readCount += 1
+                return chunks.isEmpty ? nil : chunks.removeFirst()
+            }
+            if chunk == nil {
+                onEndOfStream?()
+            }
+            completion(.success(chunk))
+        } write: { [self] data, completion in
+            if completesWritesAutomatically {
+                writeQueue.async { [self] in
+                    lock.withLock { _writtenData.append(data) }
+                    completion(nil)
+                }
+                return
+            }
+
+            let pendingWriteCount = lock.withLock {
+                pendingWrites.append((data, completion))
+                return pendingWrites.count
+            }
+            onWrite?(pendingWriteCount)
+        }
+    }
+
+    func completeNextWrite(error: Error? = nil) {
+        let write = lock.withLock {
+            let write = pendingWrites.removeFirst()
+            if error == nil {
+                _writtenData.append(write.data)
+            }
+            return write
+        }
+        write.completion(error)
+    }
+
+}
+
+final class TCPFlowRelayTests: XCTestCase {
+
+    private func chunks(count: Int, size: Int) -> [Data] {
+        (0..<count).map { Data(repeating: UInt8($0 % 256), count: size) }
+    }
+
+    func testWhenWritesCompleteAsynchronouslyThenChunksAreWrittenInOrder() async throws {
+        let chunks = chunks(count: 100, size: 16)
+        let endpoints = RelayEndpoints(chunks: chunks)
+        endpoints.completesWritesAutomatically = true
+        let relay = endpoints.makeRelay(maxBytesInFlight: 64)
+
+        try await relay.run()
+
+        XCTAssertEqual(endpoints.writtenData, chunks)
+        XCTAssertEqual(relay.byteCount, 100 * 16)
+    }
+
+    func testWhenMaxBytesInFlightIsReachedThenReadingPausesUntilWritesComplete() async throws {
+        let chunks = chunks(count: 5, size: 4)
+        let endpoints = RelayEndpoints(chunks: chunks)
+        let relay = endpoints.makeRelay(maxBytesInFlight: 10)
+
+        let threeWritesPending = expectation(description: "3 writes pending")
+        endpoints.onWrite = { pendingWriteCount in
+            if pendingWriteCount == 3 {
+                threeWritesPending.fulfill()
+            }
+        }
+        let relayTask = Task {
+            try await relay.run()
+        }
+
+        // 12 bytes in flight after the third chunk
+        await fulfillment(of: [threeWritesPending], timeout: 1)
+        XCTAssertEqual(endpoints.readCount, 3)
+
+        // 8 bytes in flight: the fourth chunk is read, then reading pauses again
+        endpoints.onWrite = nil
+        endpoints.completeNextWrite()
+        XCTAssertEqual(endpoints.readCount, 4)
+        XCTAssertEqual(endpoints.pendingWriteCount, 3)
+
+        while endpoints.pendingWriteCount > 0 {
+            endpoints.completeNextWrite()
+        }
+        try await relayTask.value
+
+        XCTAssertEqual(endpoints.writtenData, chunks)
+        // the last read returned the end of the stream
+        XCTAssertEqual(endpoints.readCount, 6)
+    }
+
+    func testWhenEndOfStreamIsReadWithWritesPendingThenRunFinishesAfterTheWrites() async throws {
+        let chunks = chunks(count: 2, size: 4)
+        let endpoints = RelayEndpoints(chunks: chunks)
+        let relay = endpoints.makeRelay(maxBytesInFlight: 1024)
+
+        let endOfStream = expectation(description: "end of stream")
+        endpoints.onEndOfStream = {
+            endOfStream.fulfill()
+        }
+        let didFinish = ManagedFlag()
+        let relayTask = Task {
+            try await relay.run()
+            didFinish.set()
+        }
+
+        await fulfillment(of: [endOfStream], timeout: 1)
+        XCTAssertEqual(endpoints.pendingWriteCount, 2)
+
+        endpoints.completeNextWrite()
+        try await Task.sleep(nanoseconds: 50_000_000)
+        XCTAssertFalse(didFinish.isSet)
+
+        endpoints.completeNextWrite()
+        try await relayTask.value
+
+        XCTAssertTrue(didFinish.isSet)
+        XCTAssertEqual(endpoints.writtenData, chunks)
+    }
+
+    func testWhenWritesFailThenRunThrowsFirstErrorOnce() async throws {
+        let endpoints = RelayEndpoints(chunks: chunks(count: 3, size: 4))
+        let relay = endpoints.makeRelay(maxBytesInFlight: 1024)
+
+        let writesPending = expectation(description: "writes pending")
+        endpoints.onWrite = { pendingWriteCount in
+            if pendingWriteCount == 3 {
+                writesPending.fulfill()
+            }
+        }
+        let relayTask = Task {
+            try await relay.run()
+        }
+        await fulfillment(of: [writesPending], timeout: 1)
+
+        // resuming the continuation more than once would crash
+        endpoints.completeNextWrite(error: RelayTestError(id: 1))
+        endpoints.completeNextWrite(error: RelayTestError(id: 2))
+        endpoints.completeNextWrite()
+
+        do {
+            try await relayTask.value
+            XCTFail("run() should throw")
+        } catch {
+            XCTAssertEqual(error as? RelayTestError, RelayTestError(id: 1))
+        }
+        // no more reads once the relay has finished
+        XCTAssertEqual(endpoints.readCount, 4)
+    }
+
+}
+
+private final class ManagedFlag {
+    private let lock = NSLock()
+    private var value = false
+
+    var isSet: Bool {
+        lock.withLock { value }
+    }
+
+    func set() {
+        lock.withLock { value = true }
+    }
+}
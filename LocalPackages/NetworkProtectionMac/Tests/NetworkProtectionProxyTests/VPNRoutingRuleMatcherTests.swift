@@ -0,0 +1,52 @@
+//
+//  VPNRoutingRuleMatcherTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+@testable import NetworkProtectionProxy
+import XCTest
+
+final class VPNRoutingRuleMatcherTests: XCTestCase {
+
+    func testWhenAppHasRuleThenRuleIsReturned() {
+        let matcher = VPNRoutingRuleMatcher(appRoutingRules: ["com.example.blocked": .block, "com.example.excluded": .exclude])
+
+        XCTAssertEqual(matcher.rule(forAppIdentifier: "com.example.blocked"), .block)
+        XCTAssertEqual(matcher.rule(forAppIdentifier: "com.example.excluded"), .exclude)
+        XCTAssertNil(matcher.rule(forAppIdentifier: "com.example.other"))
+    }
+
+    func testWhenHostnameEndsWithExcludedDomainThenItIsExcluded() {
+        let excludedDomains = ["example.com", "sub.example.org", "test.net"]
+        let matcher = VPNRoutingRuleMatcher(excludedDomains: excludedDomains)
+
+        let hostnames = ["example.com", "www.example.com", "notexample.com", "example.org", "a.sub.example.org",
+                         "example.net", "test.net.", "", "com"]
+        for hostname in hostnames {
+            // same decisions as matching every excluded domain suffix
+            let isExcluded = excludedDomains.contains { hostname.hasSuffix($0) }
+            XCTAssertEqual(matcher.isExcludedDomain(hostname), isExcluded, hostname)
+        }
+    }
+
+    func testWhenNoDomainsAreExcludedThenNoHostnameIsExcluded() {
+        let matcher = VPNRoutingRuleMatcher()
+
+        XCTAssertFalse(matcher.isExcludedDomain("example.com"))
+        XCTAssertFalse(matcher.isExcludedDomain(""))
+    }
+}
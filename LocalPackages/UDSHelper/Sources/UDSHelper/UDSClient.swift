@@ -35,6 +35,12 @@ public actor UDSClient {
     private let queue = DispatchQueue(label: "com.duckduckgo.UDSConnection.queue.\(UUID().uuidString)")
     private let payloadHandler: PayloadHandler?
 
+    /// Whether the peer on the current connection answered in binary, and can decode binary requests.
+    ///
+    /// Until then requests are sent as JSON, which older versions of the VPN agent can decode.
+    ///
+    private var peerAcceptsBinaryFrames = false
+
     // MARK: - Message completion callbacks
 
     typealias Callback = (Data?) async -> Void
@@ -83,6 +89,7 @@ public actor UDSClient {
         startReceivingMessages(on: connection)
 
         internalConnection = connection
+        peerAcceptsBinaryFrames = false
         connection.start(queue: queue)
 
         while connection.state != .ready {
@@ -121,6 +128,7 @@ public actor UDSClient {
     private func releaseConnection() {
         internalConnection?.stateUpdateHandler = nil
         internalConnection = nil
+        peerAcceptsBinaryFrames = false
     }
 
     // MARK: - Sending commands
@@ -128,7 +136,7 @@ public actor UDSClient {
     @discardableResult
     public func send(_ payload: Data) async throws -> Data? {
         let uuid = UUID()
-        let message = UDSMessage(uuid: uuid, body: .request(payload))
+        let message = UDSMessage(uuid: uuid, body: .request(payload), acceptsBinaryFrames: true)
 
         return try await send(message)
     }
@@ -152,11 +160,6 @@ public actor UDSClient {
     private func send(_ message: UDSMessage, completion: @escaping (Result<Data?, Error>) async -> Void) async {
 
         do {
-            let data = try JSONEncoder().encode(message)
-            let lengthData = withUnsafeBytes(of: UDSMessageLength(data.count)) {
-                Data($0)
-            }
-            let payload = lengthData + data
             let connection = try await connection()
 
             assert(responseCallbacks[message.uuid] == nil)
@@ -164,17 +167,24 @@ public actor UDSClient {
                 await completion(.success(data))
             }
 
+            let format: UDSMessageFormat = peerAcceptsBinaryFrames ? .binary : .json
+
+            // Requests are matched to their responses by UUID, so several can be in flight on the connection
             try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-                connection.send(content: payload, completion: .contentProcessed { error in
-                    if let error {
-                        Logger.udsHelper.error("UDSClient - Send Error \(error.localizedDescription, privacy: .public)")
-                        continuation.resume(throwing: error)
-                        return
+                do {
+                    try UDSMessageFrame.send(message, format: format, on: connection) { error in
+                        if let error {
+                            Logger.udsHelper.error("UDSClient - Send Error \(error.localizedDescription, privacy: .public)")
+                            continuation.resume(throwing: error)
+                            return
+                        }
+
+                        Logger.udsHelper.info("UDSClient - Send Success")
+                        continuation.resume()
                     }
-
-                    Logger.udsHelper.info("UDSClient - Send Success")
-                    continuation.resume()
-                })
+                } catch {
+                    continuation.resume(throwing: error)
+                }
             }
         } catch {
             responseCallbacks.removeValue(forKey: message.uuid)
@@ -189,14 +199,14 @@ public actor UDSClient {
     ///
     private func startReceivingMessages(on connection: NWConnection) {
 
-        receiver.startReceivingMessages(on: connection) { [weak self] message in
+        receiver.startReceivingMessages(on: connection) { [weak self] message, format in
             guard let self else { return false }
 
             switch message.body {
             case .request(let payload):
                 try await payloadHandler?(payload)
             case .response(let response):
-                await handleResponse(uuid: message.uuid, response: response, on: connection)
+                await handleResponse(uuid: message.uuid, response: response, format: format, on: connection)
             }
 
             return true
@@ -207,7 +217,11 @@ public actor UDSClient {
         }
     }
 
-    private func handleResponse(uuid: UUID, response: UDSMessageResponse, on connection: NWConnection) async {
+    private func handleResponse(uuid: UUID, response: UDSMessageResponse, format: UDSMessageFormat, on connection: NWConnection) async {
+        if format == .binary && connection === internalConnection {
+            peerAcceptsBinaryFrames = true
+        }
+
         guard let callback = responseCallbacks[uuid] else {
             return
         }
@@ -227,5 +241,6 @@ public actor UDSClient {
     private func closeConnection(_ connection: NWConnection) {
         internalConnection?.cancel()
         internalConnection = nil
+        peerAcceptsBinaryFrames = false
     }
 }
@@ -32,6 +32,18 @@ public struct UDSMessage: Codable {
     public let uuid: UUID
     public let body: UDSMessageBody
 
+    /// Set on JSON requests by clients that can decode binary frames, so the server can answer in binary.
+    ///
+    /// Older versions ignore it, and binary frames don't carry it.
+    ///
+    let acceptsBinaryFrames: Bool?
+
+    init(uuid: UUID, body: UDSMessageBody, acceptsBinaryFrames: Bool? = nil) {
+        self.uuid = uuid
+        self.body = body
+        self.acceptsBinaryFrames = acceptsBinaryFrames
+    }
+
     public func successResponse(withPayload payload: Data?) -> UDSMessage {
         UDSMessage(uuid: uuid, body: .response(.success(payload)))
     }
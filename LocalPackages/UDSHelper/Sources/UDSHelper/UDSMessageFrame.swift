@@ -0,0 +1,190 @@
+//
+//  UDSMessageFrame.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import Network
+
+/// The encoding of a message in a frame.
+///
+enum UDSMessageFormat {
+    /// A fixed size header followed by the raw payload.
+    case binary
+
+    /// The JSON encoded `UDSMessage`, sent by older versions of the app and the VPN agent.
+    case json
+}
+
+/// Frames `UDSMessage`s for the socket.
+///
+/// Every frame starts with its length as a `UDSMessageLength`, followed by the message.  A binary message
+/// starts with the `binaryFormatMarker`, the message kind and the message UUID, followed by the payload as is.
+/// The marker can't start a JSON object, so JSON messages from older versions can still be decoded.
+///
+enum UDSMessageFrame {
+
+    enum EncodingError: Error {
+        case messageTooLong(length: Int)
+    }
+
+    enum DecodingError: Error {
+        case invalidHeader
+        case unknownMessageKind(_ kind: UInt8)
+    }
+
+    private enum MessageKind: UInt8 {
+        case request = 0
+        case successResponse = 1
+        case successResponseWithoutPayload = 2
+        case failureResponse = 3
+    }
+
+    static let binaryFormatMarker: UInt8 = 0x01
+    static let lengthSize = MemoryLayout<UDSMessageLength>.size
+    private static let binaryHeaderSize = 2 + MemoryLayout<uuid_t>.size
+    private static let jsonObjectStart = UInt8(ascii: "{")
+
+    // MARK: - Encoding
+
+    /// Encodes a message, returning the frame header and the payload to be sent after it.
+    ///
+    /// The payload is returned separately so it's sent without being copied into the frame.
+    ///
+    static func encode(_ message: UDSMessage, format: UDSMessageFormat = .binary) throws -> (header: Data, payload: Data?) {
+        switch format {
+        case .binary:
+            let (kind, payload): (MessageKind, Data?) = {
+                switch message.body {
+                case .request(let payload):
+                    return (.request, payload)
+                case .response(.success(let payload?)):
+                    return (.successResponse, payload)
+                case .response(.success(nil)):
+                    return (.successResponseWithoutPayload, nil)
+                case .response(.failure):
+                    return (.failureResponse, nil)
+                }
+            }()
+
+            var header = try lengthData(for: binaryHeaderSize + (payload?.count ?? 0))
+            header.reserveCapacity(lengthSize + binaryHeaderSize)
+            header.append(binaryFormatMarker)
+            header.append(kind.rawValue)
+            withUnsafeBytes(of: message.uuid.uuid) { header.append(contentsOf: $0) }
+
+            return (header, payload)
+
+        case .json:
+            let data = try JSONEncoder().encode(message)
+            return (try lengthData(for: data.count) + data, nil)
+        }
+    }
+
+    private static func lengthData(for length: Int) throws -> Data {
+        guard let length = UDSMessageLength(exactly: length) else {
+            throw EncodingError.messageTooLong(length: length)
+        }
+        return withUnsafeBytes(of: length) { Data($0) }
+    }
+
+    /// Sends a message, without waiting for the previous messages to be processed.
+    ///
+    static func send(_ message: UDSMessage, format: UDSMessageFormat = .binary, on connection: NWConnection, completion: @escaping (Error?) -> Void) throws {
+        let (header, payload) = try encode(message, format: format)
+
+        guard let payload, !payload.isEmpty else {
+            connection.send(content: header, completion: .contentProcessed(completion))
+            return
+        }
+
+        connection.batch {
+            // Errors are reported by the payload completion
+            connection.send(content: header, completion: .contentProcessed { _ in })
+            connection.send(content: payload, completion: .contentProcessed(completion))
+        }
+    }
+
+    // MARK: - Decoding
+
+    /// Returns the message of the first complete frame in the buffer, along with the frame length.
+    ///
+    /// - Returns: `nil` if the buffer doesn't contain a complete frame yet.
+    ///
+    static func firstMessageData(in buffer: Data) -> (messageData: Data, frameLength: Int)? {
+        guard let frameLength = firstFrameLength(in: buffer),
+              buffer.count >= frameLength else {
+            return nil
+        }
+
+        return (buffer[buffer.startIndex + lengthSize ..< buffer.startIndex + frameLength], frameLength)
+    }
+
+    /// Returns the length of the first frame in the buffer, including its length prefix.
+    ///
+    /// - Returns: `nil` if the buffer doesn't contain the length prefix yet.
+    ///
+    static func firstFrameLength(in buffer: Data) -> Int? {
+        guard buffer.count >= lengthSize else {
+            return nil
+        }
+
+        var length: UDSMessageLength = 0
+        withUnsafeMutableBytes(of: &length) { buffer.copyBytes(to: $0, from: buffer.startIndex ..< buffer.startIndex + lengthSize) }
+        return lengthSize + Int(length)
+    }
+
+    /// Decodes a message, in either format.
+    ///
+    static func decode(_ data: Data) throws -> (message: UDSMessage, format: UDSMessageFormat) {
+        guard let marker = data.first else {
+            throw DecodingError.invalidHeader
+        }
+
+        guard marker != jsonObjectStart else {
+            return (try JSONDecoder().decode(UDSMessage.self, from: data), .json)
+        }
+
+        guard marker == binaryFormatMarker, data.count >= binaryHeaderSize else {
+            throw DecodingError.invalidHeader
+        }
+
+        let kindValue = data[data.startIndex + 1]
+        guard let kind = MessageKind(rawValue: kindValue) else {
+            throw DecodingError.unknownMessageKind(kindValue)
+        }
+
+        var uuid = UUID().uuid
+        withUnsafeMutableBytes(of: &uuid) { data.copyBytes(to: $0, from: data.startIndex + 2 ..< data.startIndex + binaryHeaderSize) }
+
+        // Copied so the payload indices start at zero, and the receive buffer can be released
+        let payload = Data(data[(data.startIndex + binaryHeaderSize)...])
+
+        let body: UDSMessageBody
+        switch kind {
+        case .request:
+            body = .request(payload)
+        case .successResponse:
+            body = .response(.success(payload))
+        case .successResponseWithoutPayload:
+            body = .response(.success(nil))
+        case .failureResponse:
+            body = .response(.failure)
+        }
+
+        return (UDSMessage(uuid: UUID(uuid: uuid), body: body), .binary)
+    }
+}
@@ -27,7 +27,13 @@ struct UDSReceiver {
     /// The return value allows the callback handler to continue receiving messages (if it returns `true`)
     /// or stop receiving messages (when it returns `false`).
     ///
-    typealias MessageHandler = (UDSMessage) async throws -> Bool
+    /// The format of the message is passed along so it can be answered in the same format.
+    ///
+    typealias MessageHandler = (UDSMessage, UDSMessageFormat) async throws -> Bool
+
+    /// Up to this many bytes are read at once, which can hold several small messages.
+    ///
+    static let maxReceiveLength = UDSMessageFrame.lengthSize + Int(UDSMessageLength.max)
 
     enum ReadError: Error {
         case notEnoughData(expected: Int, received: Int)
@@ -49,12 +55,14 @@ struct UDSReceiver {
 
     private func runReceiveMessageLoop(on connection: NWConnection, messageHandler: @escaping MessageHandler, onError errorHandler: @escaping (Error) async -> Bool) async {
 
+        // Received data not decoded yet, kept across messages
+        var buffer = Data()
+
         while true {
             do {
-                let length = try await receiveMessageLength(on: connection)
-                let message = try await receiveEncodedObjectData(ofLength: length, on: connection)
+                let (message, format) = try await receiveNextMessage(on: connection, buffer: &buffer)
 
-                guard try await messageHandler(message) else {
+                guard try await messageHandler(message, format) else {
                     return
                 }
             } catch {
@@ -88,81 +96,48 @@ struct UDSReceiver {
         }
     }
 
-    /// Receives the length value for the next message in the data stream.
+    /// Receives the next message, reading from the connection only when the buffer doesn't hold a complete frame.
     ///
     /// - Parameters:
-    ///     - connection: the connection through which we're receveing messages
+    ///     - connection: the connection through which we're receiving messages.
+    ///     - buffer: the received data not decoded yet, the frame of the returned message is removed from it.
     ///
-    /// - Returns: the length of the next message
+    /// - Returns: the message and its format.
     ///
-    private func receiveMessageLength(on connection: NWConnection) async throws -> UDSMessageLength {
-        try await withCheckedThrowingContinuation { continuation in
-            let messageLengthMemorySize = MemoryLayout<UDSMessageLength>.size
-
-            connection.receive(minimumIncompleteLength: messageLengthMemorySize, maximumLength: messageLengthMemorySize) { (data, _, isComplete, error) in
-
-                if let data = data {
-                    guard data.count == messageLengthMemorySize else {
-                        continuation.resume(throwing: ReadError.notEnoughData(expected: messageLengthMemorySize, received: data.count))
-                        return
-                    }
+    private func receiveNextMessage(on connection: NWConnection, buffer: inout Data) async throws -> (UDSMessage, UDSMessageFormat) {
+        while true {
+            if let (messageData, frameLength) = UDSMessageFrame.firstMessageData(in: buffer) {
+                // Removed before decoding, so a message that can't be decoded isn't read again
+                buffer = buffer.count == frameLength ? Data() : buffer[(buffer.startIndex + frameLength)...]
+                return try UDSMessageFrame.decode(messageData)
+            }
 
-                    let length = data.withUnsafeBytes { $0.load(as: UDSMessageLength.self) }
-                    continuation.resume(returning: length)
-                }
+            let (data, isComplete) = try await receive(on: connection)
 
-                if let error {
-                    continuation.resume(throwing: ReadError.connectionError(error))
-                    return
-                }
+            if let data {
+                buffer.append(data)
+            }
 
-                guard !isComplete else {
-                    continuation.resume(throwing: ReadError.connectionClosed)
-                    return
+            if isComplete && UDSMessageFrame.firstMessageData(in: buffer) == nil {
+                guard buffer.isEmpty else {
+                    let expected = UDSMessageFrame.firstFrameLength(in: buffer) ?? UDSMessageFrame.lengthSize
+                    throw ReadError.notEnoughData(expected: expected, received: buffer.count)
                 }
+                throw ReadError.connectionClosed
             }
         }
     }
 
-    /// Decodes an incoming message.
-    ///
-    /// - Parameters:
-    ///     - length: the length of the data that represents the next message.
-    ///     - connection: the connection through which we're receiving the message.
-    ///
-    /// - Returns: a message on success.
-    ///
-    private func receiveEncodedObjectData(ofLength length: UDSMessageLength, on connection: NWConnection) async throws -> UDSMessage {
+    private func receive(on connection: NWConnection) async throws -> (data: Data?, isComplete: Bool) {
         try await withCheckedThrowingContinuation { continuation in
-            connection.receive(minimumIncompleteLength: Int(length), maximumLength: Int(length)) { (data, _, isComplete, error) in
-                if let data = data {
-                    guard data.count == length else {
-                        continuation.resume(throwing: ReadError.notEnoughData(expected: Int(length), received: data.count))
-                        return
-                    }
-
-                    do {
-                        let message = try self.decodeMessage(from: data)
-                        continuation.resume(returning: message)
-                    } catch {
-                        continuation.resume(throwing: error)
-                    }
-                }
-
+            connection.receive(minimumIncompleteLength: 1, maximumLength: Self.maxReceiveLength) { (data, _, isComplete, error) in
                 if let error {
                     continuation.resume(throwing: ReadError.connectionError(error))
                     return
                 }
 
-                guard !isComplete else {
-                    continuation.resume(throwing: ReadError.connectionClosed)
-                    return
-                }
+                continuation.resume(returning: (data, isComplete))
             }
         }
     }
-
-    private func decodeMessage(from data: Data) throws -> UDSMessage {
-        try JSONDecoder().decode(UDSMessage.self, from: data)
-    }
 }
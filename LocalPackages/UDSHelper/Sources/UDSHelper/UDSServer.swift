@@ -218,14 +218,17 @@ public final class UDSServer {
     ///
     private func startReceivingMessages(on connection: NWConnection, messageHandler: @escaping (Data) async throws -> Data?) {
 
-        receiver.startReceivingMessages(on: connection) { [weak self] message in
+        receiver.startReceivingMessages(on: connection) { [weak self] message, format in
             guard let self else { return false }
 
             switch message.body {
             case .request(let data):
                 let responsePayload = try await messageHandler(data)
                 let responseMessage = message.successResponse(withPayload: responsePayload)
-                try await self.send(responseMessage, connection: connection)
+                // Answered in the format of the request, which older clients can decode, unless the client
+                // says it accepts binary frames
+                let responseFormat: UDSMessageFormat = message.acceptsBinaryFrames == true ? .binary : format
+                try await self.send(responseMessage, format: responseFormat, connection: connection)
             case .response:
                 // We still don't fully support server to client messages.  This is the location where we'd
                 // add the handling for that.
@@ -243,24 +246,23 @@ public final class UDSServer {
         }
     }
 
-    private func send(_ message: UDSMessage, connection: NWConnection) async throws {
-
-        let data = try JSONEncoder().encode(message)
-        let lengthData = withUnsafeBytes(of: UDSMessageLength(data.count)) {
-            Data($0)
-        }
+    private func send(_ message: UDSMessage, format: UDSMessageFormat, connection: NWConnection) async throws {
 
         try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-            connection.send(content: lengthData + data, completion: .contentProcessed { error in
-                if let error {
-                    Logger.udsHelper.error("UDSServer - Send Error \(error.localizedDescription, privacy: .public)")
-                    continuation.resume(throwing: error)
-                    return
+            do {
+                try UDSMessageFrame.send(message, format: format, on: connection) { error in
+                    if let error {
+                        Logger.udsHelper.error("UDSServer - Send Error \(error.localizedDescription, privacy: .public)")
+                        continuation.resume(throwing: error)
+                        return
+                    }
+
+                    Logger.udsHelper.info("UDSServer - Send Success")
+                    continuation.resume()
                 }
-
-                Logger.udsHelper.info("UDSServer - Send Success")
-                continuation.resume()
-            })
+            } catch {
+                continuation.resume(throwing: error)
+            }
         }
     }
 }
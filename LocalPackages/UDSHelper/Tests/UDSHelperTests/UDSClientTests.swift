@@ -0,0 +1,165 @@
+//
+//  UDSClientTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import Network
+import XCTest
+@testable import UDSHelper
+
+/// The message as decoded by older versions of the VPN agent.
+///
+private struct JSONOnlyMessage: Codable {
+    let uuid: UUID
+    let body: UDSMessageBody
+}
+
+/// A peer which only understands JSON frames, like older versions of the VPN agent.
+///
+/// Every request is answered with its payload reversed.  A frame it can't decode closes the connection.
+///
+private final class JSONOnlyPeer {
+
+    private let listener: NWListener
+    private let queue = DispatchQueue(label: "com.duckduckgo.UDSClientTests.JSONOnlyPeer")
+    private let lock = NSLock()
+    private var _receivedRequests = [Data]()
+
+    var receivedRequests: [Data] {
+        lock.withLock { _receivedRequests }
+    }
+
+    init(socketFileURL: URL) throws {
+        let params = NWParameters()
+        params.defaultProtocolStack.transportProtocol = NWProtocolTCP.Options()
+        params.requiredLocalEndpoint = NWEndpoint.unix(path: socketFileURL.path)
+        params.allowLocalEndpointReuse = true
+        listener = try NWListener(using: params)
+    }
+
+    func start() async {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            listener.stateUpdateHandler = { [listener] state in
+                guard case .ready = state else { return }
+                listener.stateUpdateHandler = nil
+                continuation.resume()
+            }
+            listener.newConnectionHandler = { [weak self] connection in
+                guard let self else { return }
+                connection.start(queue: queue)
+                receiveFrame(on: connection)
+            }
+            listener.start(queue: queue)
+        }
+    }
+
+    func stop() {
+        listener.cancel()
+    }
+
+    private func receiveFrame(on connection: NWConnection) {
+        let lengthSize = MemoryLayout<UDSMessageLength>.size
+
+        connection.receive(minimumIncompleteLength: lengthSize, maximumLength: lengthSize) { [weak self] data, _, _, error in
+            guard let self, let data, data.count == lengthSize, error == nil else {
+                connection.cancel()
+                return
+            }
+
+            let length = data.withUnsafeBytes { $0.loadUnaligned(as: UDSMessageLength.self) }
+            connection.receive(minimumIncompleteLength: Int(length), maximumLength: Int(length)) { data, _, _, error in
+                guard let data, error == nil,
+                      let message = try? JSONDecoder().decode(JSONOnlyMessage.self, from: data),
+                      case .request(let payload) = message.body else {
+                    connection.cancel()
+                    return
+                }
+
+                self.lock.withLock { self._receivedRequests.append(payload) }
+
+                let response = JSONOnlyMessage(uuid: message.uuid, body: .response(.success(Data(payload.reversed()))))
+                let responseData = try! JSONEncoder().encode(response)
+                let lengthData = withUnsafeBytes(of: UDSMessageLength(responseData.count)) { Data($0) }
+                connection.send(content: lengthData + responseData, completion: .idempotent)
+
+                self.receiveFrame(on: connection)
+            }
+        }
+    }
+}
+
+final class UDSClientTests: XCTestCase {
+
+    private var socketFileURL: URL!
+
+    override func setUp() {
+        // Kept short, as socket paths have a maximum length
+        socketFileURL = URL(fileURLWithPath: "/tmp/uds-\(UUID().uuidString.prefix(8)).sock")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: socketFileURL)
+    }
+
+    func testWhenPeerOnlyDecodesJSONThenClientRequestsAreAnswered() async throws {
+        let peer = try JSONOnlyPeer(socketFileURL: socketFileURL)
+        await peer.start()
+        defer { peer.stop() }
+
+        let client = UDSClient(socketFileURL: socketFileURL)
+        let requests = ["first", "second", "third"].map { $0.data(using: .utf8)! }
+
+        // The peer answers in JSON, so every request must be sent as JSON too
+        for request in requests {
+            let response = try await client.send(request)
+            XCTAssertEqual(response, Data(request.reversed()))
+        }
+
+        XCTAssertEqual(peer.receivedRequests, requests)
+    }
+
+    func testWhenPeerAcceptsBinaryFramesThenClientRequestsAreAnswered() async throws {
+        let server = UDSServer(socketFileURL: socketFileURL)
+        try server.start { payload in
+            Data(payload.reversed())
+        }
+        defer { server.stop() }
+        while !FileManager.default.fileExists(atPath: socketFileURL.path) {
+            try await Task.sleep(nanoseconds: 10 * NSEC_PER_MSEC)
+        }
+
+        let client = UDSClient(socketFileURL: socketFileURL)
+        let requests = ["first", "second", "third"].map { $0.data(using: .utf8)! }
+
+        // The first request is sent as JSON, and the following ones in binary once the server answered in binary
+        for request in requests {
+            let response = try await client.send(request)
+            XCTAssertEqual(response, Data(request.reversed()))
+        }
+    }
+
+    func testWhenRequestAcceptsBinaryFramesThenItIsStillDecodedAsJSONByOlderVersions() throws {
+        let message = UDSMessage(uuid: UUID(), body: .request("request".data(using: .utf8)!), acceptsBinaryFrames: true)
+        let (frame, payload) = try UDSMessageFrame.encode(message, format: .json)
+        XCTAssertNil(payload)
+
+        let decoded = try JSONDecoder().decode(JSONOnlyMessage.self, from: frame.dropFirst(UDSMessageFrame.lengthSize))
+
+        XCTAssertEqual(decoded.uuid, message.uuid)
+        XCTAssertEqual(try JSONEncoder().encode(decoded.body), try JSONEncoder().encode(message.body))
+    }
+}
@@ -0,0 +1,88 @@
+//
+//  UDSMessageFrameTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import UDSHelper
+
+final class UDSMessageFrameTests: XCTestCase {
+
+    private func frame(_ message: UDSMessage, format: UDSMessageFormat = .binary) throws -> Data {
+        let (header, payload) = try UDSMessageFrame.encode(message, format: format)
+        return header + (payload ?? Data())
+    }
+
+    private func assertEqual(_ lhs: UDSMessage, _ rhs: UDSMessage, file: StaticString = #file, line: UInt = #line) throws {
+        XCTAssertEqual(lhs.uuid, rhs.uuid, file: file, line: line)
+        XCTAssertEqual(try JSONEncoder().encode(lhs.body), try JSONEncoder().encode(rhs.body), file: file, line: line)
+    }
+
+    func testWhenMessageIsFramedThenItIsDecodedFromTheFrame() throws {
+        let uuid = UUID()
+        let messages = [
+            UDSMessage(uuid: uuid, body: .request("request".data(using: .utf8)!)),
+            UDSMessage(uuid: uuid, body: .request(Data())),
+            UDSMessage(uuid: uuid, body: .response(.success("response".data(using: .utf8)!))),
+            UDSMessage(uuid: uuid, body: .response(.success(nil))),
+            UDSMessage(uuid: uuid, body: .response(.failure))
+        ]
+
+        for message in messages {
+            let frame = try frame(message)
+            let (messageData, frameLength) = try XCTUnwrap(UDSMessageFrame.firstMessageData(in: frame))
+            XCTAssertEqual(frameLength, frame.count)
+
+            let (decoded, format) = try UDSMessageFrame.decode(messageData)
+            XCTAssertEqual(format, .binary)
+            try assertEqual(decoded, message)
+        }
+    }
+
+    func testWhenMessageIsJSONEncodedThenItIsStillDecoded() throws {
+        let message = UDSMessage(uuid: UUID(), body: .request("request".data(using: .utf8)!))
+        let frame = try frame(message, format: .json)
+
+        let (messageData, _) = try XCTUnwrap(UDSMessageFrame.firstMessageData(in: frame))
+        let (decoded, format) = try UDSMessageFrame.decode(messageData)
+
+        XCTAssertEqual(format, .json)
+        try assertEqual(decoded, message)
+    }
+
+    func testWhenBufferHoldsPartialFrameThenNoMessageIsReturnedUntilItIsComplete() throws {
+        let first = UDSMessage(uuid: UUID(), body: .request("first".data(using: .utf8)!))
+        let second = UDSMessage(uuid: UUID(), body: .request("second".data(using: .utf8)!))
+        let stream = try frame(first) + frame(second)
+
+        XCTAssertNil(UDSMessageFrame.firstMessageData(in: stream.prefix(1)))
+        XCTAssertNil(UDSMessageFrame.firstMessageData(in: stream.prefix(5)))
+
+        let (firstData, firstFrameLength) = try XCTUnwrap(UDSMessageFrame.firstMessageData(in: stream))
+        try assertEqual(UDSMessageFrame.decode(firstData).message, first)
+
+        let remaining = stream[(stream.startIndex + firstFrameLength)...]
+        let (secondData, secondFrameLength) = try XCTUnwrap(UDSMessageFrame.firstMessageData(in: remaining))
+        XCTAssertEqual(firstFrameLength + secondFrameLength, stream.count)
+        try assertEqual(UDSMessageFrame.decode(secondData).message, second)
+    }
+
+    func testWhenPayloadDoesNotFitInFrameThenEncodingFails() {
+        let message = UDSMessage(uuid: UUID(), body: .request(Data(count: Int(UDSMessageLength.max))))
+
+        XCTAssertThrowsError(try UDSMessageFrame.encode(message))
+    }
+}
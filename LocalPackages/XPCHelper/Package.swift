@@ -44,6 +44,10 @@ let package = Package(
 
         .target(
             name: "XPCDelegateProxy"
+        ),
+        .testTarget(
+            name: "XPCHelperTests",
+            dependencies: ["XPCHelper", "XPCDelegateProxy"]
         )
     ]
 )
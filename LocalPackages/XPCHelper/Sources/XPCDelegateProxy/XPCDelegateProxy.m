@@ -19,8 +19,105 @@
 //
 
 #import <Foundation/Foundation.h>
+#import <objc/runtime.h>
+#import <os/lock.h>
 #import "XPCDelegateProxy.h"
 
+/// Cached result of a selector lookup: whether the owner responds to it and the resolved method signature.
+@interface XPCDelegateProxySelectorInfo : NSObject
+
+@property (nonatomic, readonly) BOOL respondsToSelector;
+@property (nonatomic, readonly, nullable) NSMethodSignature *methodSignature;
+
+@end
+
+@implementation XPCDelegateProxySelectorInfo
+
+- (instancetype)initWithRespondsToSelector:(BOOL)respondsToSelector methodSignature:(NSMethodSignature *)methodSignature {
+    self = [super init];
+    if (self) {
+        _respondsToSelector = respondsToSelector;
+        _methodSignature = methodSignature;
+    }
+    return self;
+}
+
+@end
+
+static os_unfair_lock XPCDelegateProxyCacheLock = OS_UNFAIR_LOCK_INIT;
+
+/// Whether the delegate answers selector lookups the same way as any other instance of its class.
+///
+/// Proxies, KVO (isa-swizzled) instances and classes customizing message lookup or forwarding may answer differently
+/// per instance or over time, so their lookups are never cached.
+static BOOL XPCDelegateProxyCanCacheLookups(id delegate, Class delegateClass) {
+    if ([delegate isProxy] || [delegate class] != delegateClass) {
+        return NO;
+    }
+
+    Class rootClass = [NSObject class];
+    SEL instanceSelectors[] = { @selector(respondsToSelector:), @selector(forwardingTargetForSelector:), @selector(methodSignatureForSelector:) };
+    for (size_t i = 0; i < sizeof(instanceSelectors) / sizeof(instanceSelectors[0]); i++) {
+        if (class_getMethodImplementation(delegateClass, instanceSelectors[i]) != class_getMethodImplementation(rootClass, instanceSelectors[i])) {
+            return NO;
+        }
+    }
+
+    SEL resolveSelector = @selector(resolveInstanceMethod:);
+    return class_getMethodImplementation(object_getClass(delegateClass), resolveSelector) == class_getMethodImplementation(object_getClass(rootClass), resolveSelector);
+}
+
+/// Returns the cached selector info for the delegate class, computing and storing it on first use.
+/// Classes are never deallocated so they're used as opaque, unretained keys; selectors are interned.
+static XPCDelegateProxySelectorInfo *XPCDelegateProxyCachedInfo(Class delegateClass, SEL selector, XPCDelegateProxySelectorInfo *(^compute)(void)) {
+    static NSMapTable<id, NSMapTable<id, XPCDelegateProxySelectorInfo *> *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                          valueOptions:NSPointerFunctionsStrongMemory
+                                              capacity:0];
+    });
+
+    os_unfair_lock_lock(&XPCDelegateProxyCacheLock);
+    NSMapTable *selectors = [cache objectForKey:(__bridge id)(void *)delegateClass];
+    XPCDelegateProxySelectorInfo *info = [selectors objectForKey:(__bridge id)(void *)selector];
+    os_unfair_lock_unlock(&XPCDelegateProxyCacheLock);
+
+    if (info) {
+        return info;
+    }
+
+    // Computed outside of the lock, so no arbitrary code is called while holding it.  Racing computations yield the same result.
+    info = compute();
+
+    os_unfair_lock_lock(&XPCDelegateProxyCacheLock);
+    selectors = [cache objectForKey:(__bridge id)(void *)delegateClass];
+    if (!selectors) {
+        selectors = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                              valueOptions:NSPointerFunctionsStrongMemory
+                                                  capacity:0];
+        [cache setObject:selectors forKey:(__bridge id)(void *)delegateClass];
+    }
+    [selectors setObject:info forKey:(__bridge id)(void *)selector];
+    os_unfair_lock_unlock(&XPCDelegateProxyCacheLock);
+
+    return info;
+}
+
+static XPCDelegateProxySelectorInfo *XPCDelegateProxyInfoForDelegate(id delegate, SEL selector) {
+    XPCDelegateProxySelectorInfo *(^compute)(void) = ^{
+        BOOL responds = [delegate respondsToSelector:selector];
+        NSMethodSignature *signature = responds ? [delegate methodSignatureForSelector:selector] : nil;
+        return [[XPCDelegateProxySelectorInfo alloc] initWithRespondsToSelector:responds methodSignature:signature];
+    };
+
+    Class delegateClass = object_getClass(delegate);
+    if (!XPCDelegateProxyCanCacheLookups(delegate, delegateClass)) {
+        return compute();
+    }
+
+    return XPCDelegateProxyCachedInfo(delegateClass, selector, compute);
+}
 
 @implementation XPCDelegateProxy
 
@@ -29,13 +126,38 @@
     return self;
 }
 
+/// Fast path: messages the delegate implements are sent to it directly, skipping `NSInvocation`.
+///
+- (id)forwardingTargetForSelector:(SEL)sel {
+    id delegate = self.delegate;
+
+    if (delegate && XPCDelegateProxyInfoForDelegate(delegate, sel).respondsToSelector) {
+        return delegate;
+    }
+
+    return nil;
+}
+
+/// Slow path, only reached for messages the delegate doesn't implement (or when the delegate is gone).
+///
 - (NSMethodSignature *)methodSignatureForSelector:(SEL)sel {
-    return [self.delegate methodSignatureForSelector:sel];
+    id delegate = self.delegate;
+
+    if (delegate) {
+        XPCDelegateProxySelectorInfo *info = XPCDelegateProxyInfoForDelegate(delegate, sel);
+        if (info.respondsToSelector) {
+            return info.methodSignature;
+        }
+    }
+
+    return [delegate methodSignatureForSelector:sel];
 }
 
 - (void)forwardInvocation:(NSInvocation *)invocation {
-    if ([self.delegate respondsToSelector:[invocation selector]]) {
-        [invocation invokeWithTarget:self.delegate];
+    id delegate = self.delegate;
+
+    if (delegate && XPCDelegateProxyInfoForDelegate(delegate, invocation.selector).respondsToSelector) {
+        [invocation invokeWithTarget:delegate];
     }
 }
 
@@ -18,6 +18,14 @@
 
 @import Foundation;
 
+/// Forwards messages to a weakly held delegate.
+///
+/// Messages the delegate implements are redirected through `forwardingTargetForSelector:` without building an
+/// `NSInvocation`.  Other messages go through `forwardInvocation:`, and are dropped if the delegate doesn't respond to them.
+///
+/// Responds-to and method signature lookups are cached per delegate class, unless instances of the class may answer
+/// them differently (proxies, KVO-observed instances, classes overriding message lookup or forwarding).
+///
 @interface XPCDelegateProxy: NSProxy
 
 @property (nonatomic, weak, nullable) id delegate;
@@ -0,0 +1,98 @@
+//
+//  XPCCallBatcher.swift
+//
+//  Copyright © 2024 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/// Collects fire-and-forget XPC calls and hands them over in batches, once per flush interval.
+///
+/// Calls enqueued with a coalescing key are latest-value-wins: enqueuing a new call with the same key drops the
+/// pending one.  Calls without a key are never dropped, and all calls are flushed in the order they were enqueued.
+///
+final class XPCCallBatcher<Interface: AnyObject> {
+
+    typealias Call = (Interface) -> Void
+    typealias FlushHandler = ([Call]) -> Void
+
+    private let interval: DispatchTimeInterval
+    private let queue: DispatchQueue
+    private let flushHandler: FlushHandler
+
+    /// Only accessed from `queue`.
+    ///
+    /// Coalesced calls are cleared in place and skipped when flushing, and `pendingCallIndexes` maps each coalescing key
+    /// to the index of its pending call, so replacing a call doesn't need to search the pending calls.
+    ///
+    private var pendingCalls = [Call?]()
+    private var pendingCallIndexes = [String: Int]()
+    private var flushScheduled = false
+
+    init(interval: DispatchTimeInterval,
+         queue: DispatchQueue = DispatchQueue(label: "com.duckduckgo.XPCCallBatcher.queue"),
+         flushHandler: @escaping FlushHandler) {
+
+        self.interval = interval
+        self.queue = queue
+        self.flushHandler = flushHandler
+    }
+
+    func enqueue(coalescingKey: String?, call: @escaping Call) {
+        queue.async {
+            if let coalescingKey {
+                if let index = self.pendingCallIndexes[coalescingKey] {
+                    self.pendingCalls[index] = nil
+                }
+                self.pendingCallIndexes[coalescingKey] = self.pendingCalls.endIndex
+            }
+
+            self.pendingCalls.append(call)
+            self.scheduleFlushIfNeeded()
+        }
+    }
+
+    /// Flushes all pending calls right away.
+    ///
+    func flush() {
+        queue.async {
+            self.flushPendingCalls()
+        }
+    }
+
+    private func scheduleFlushIfNeeded() {
+        guard !flushScheduled else {
+            return
+        }
+
+        flushScheduled = true
+        queue.asyncAfter(deadline: .now() + interval) { [weak self] in
+            self?.flushPendingCalls()
+        }
+    }
+
+    private func flushPendingCalls() {
+        flushScheduled = false
+
+        guard !pendingCalls.isEmpty else {
+            return
+        }
+
+        let calls = pendingCalls.compactMap { $0 }
+        pendingCalls.removeAll(keepingCapacity: true)
+        pendingCallIndexes.removeAll(keepingCapacity: true)
+        flushHandler(calls)
+    }
+}
@@ -40,6 +40,10 @@ public final class XPCClient<ClientInterface: AnyObject, ServerInterface: AnyObj
     private let serverInterface: NSXPCInterface
     public var onDisconnect: (() -> Void)?
 
+    /// Opt-in batching for calls made through `executeBatched`.  Only set in `init`, so it can be read from any thread.
+    ///
+    private var batcher: XPCCallBatcher<ServerInterface>?
+
     /// The internal connection, which may still not have been created.
     ///
     @XPCConnectionActor
@@ -70,13 +74,30 @@ public final class XPCClient<ClientInterface: AnyObject, ServerInterface: AnyObj
 
     // MARK: - Initialization
 
+    /// - Parameters:
+    ///     - batchingInterval: when set, calls made through `executeBatched` are delivered together once per interval,
+    ///         using a single hop to the connection.  Meant for high-rate, fire-and-forget calls such as status or progress updates.
+    ///
     public init(machServiceName: String,
                 clientInterface: NSXPCInterface,
-                serverInterface: NSXPCInterface) {
+                serverInterface: NSXPCInterface,
+                batchingInterval: DispatchTimeInterval? = nil) {
 
         self.machServiceName = machServiceName
         self.clientInterface = clientInterface
         self.serverInterface = serverInterface
+
+        if let batchingInterval {
+            batcher = XPCCallBatcher(interval: batchingInterval) { [weak self] calls in
+                self?.execute(call: { server in
+                    for call in calls {
+                        call(server)
+                    }
+                }, xpcReplyErrorHandler: { _ in
+                    // Batched calls are fire-and-forget
+                })
+            }
+        }
     }
 
     deinit {
@@ -129,4 +150,22 @@ public final class XPCClient<ClientInterface: AnyObject, ServerInterface: AnyObj
             call(serverInterface)
         }
     }
+
+    // MARK: - Batching
+
+    /// Executes a fire-and-forget call, batching it if batching is enabled.
+    ///
+    /// - Parameters:
+    ///     - coalescingKey: when set, a pending call with the same key is replaced by this one (latest value wins).
+    ///         Calls without a key are always delivered, in order.
+    ///     - call: the call to execute.
+    ///
+    public func executeBatched(coalescingKey: String? = nil, call: @escaping (ServerInterface) -> Void) {
+        guard let batcher else {
+            execute(call: call, xpcReplyErrorHandler: { _ in })
+            return
+        }
+
+        batcher.enqueue(coalescingKey: coalescingKey, call: call)
+    }
 }
@@ -80,6 +80,10 @@ public final class XPCServer<ClientInterface: AnyObject, ServerInterface: AnyObj
 
     private let connectionsManager: XPCConnectionsManager
 
+    /// Opt-in batching for calls made through `forEachClientBatched`.  Only set in `init`, so it can be read from any thread.
+    ///
+    private var batcher: XPCCallBatcher<ClientInterface>?
+
     /// The new-connections listener
     ///
     private let listener: NSXPCListener
@@ -96,9 +100,14 @@ public final class XPCServer<ClientInterface: AnyObject, ServerInterface: AnyObj
         }
     }
 
+    /// - Parameters:
+    ///     - batchingInterval: when set, calls made through `forEachClientBatched` are delivered to every client
+    ///         together once per interval.  Meant for high-rate, fire-and-forget calls such as status or progress updates.
+    ///
     public init(machServiceName: String,
                 clientInterface: NSXPCInterface,
-                serverInterface: NSXPCInterface) {
+                serverInterface: NSXPCInterface,
+                batchingInterval: DispatchTimeInterval? = nil) {
 
         listener = NSXPCListener(machServiceName: machServiceName)
         self.clientInterface = clientInterface
@@ -107,6 +116,16 @@ public final class XPCServer<ClientInterface: AnyObject, ServerInterface: AnyObj
         connectionsManager = XPCConnectionsManager(clientInterface: clientInterface, serverInterface: serverInterface)
 
         listener.delegate = connectionsManager
+
+        if let batchingInterval {
+            batcher = XPCCallBatcher(interval: batchingInterval) { [weak self] calls in
+                self?.forEachClient { client in
+                    for call in calls {
+                        call(client)
+                    }
+                }
+            }
+        }
     }
 
     deinit {
@@ -149,4 +168,22 @@ extension XPCServer {
             }
         }
     }
+
+    // MARK: - Batching
+
+    /// Sends a fire-and-forget call to all connected clients, batching it if batching is enabled.
+    ///
+    /// - Parameters:
+    ///     - coalescingKey: when set, a pending call with the same key is replaced by this one (latest value wins).
+    ///         Calls without a key are always delivered, in order.
+    ///     - callback: the call to execute for each client.
+    ///
+    public func forEachClientBatched(coalescingKey: String? = nil, do callback: @escaping (ClientInterface) -> Void) {
+        guard let batcher else {
+            forEachClient(do: callback)
+            return
+        }
+
+        batcher.enqueue(coalescingKey: coalescingKey, call: callback)
+    }
 }
@@ -0,0 +1,130 @@
+//
+//  XPCCallBatcherTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import XCTest
+@testable import XPCHelper
+
+private final class Recorder {
+    var values = [String]()
+}
+
+final class XPCCallBatcherTests: XCTestCase {
+
+    private let queue = DispatchQueue(label: "com.duckduckgo.XPCCallBatcherTests.queue")
+    private let recorder = Recorder()
+    private var batches = [[String]]()
+
+    /// Makes a batcher which records each flushed batch, fulfilling `expectation` on every flush.
+    ///
+    private func makeBatcher(interval: DispatchTimeInterval, expectation: XCTestExpectation? = nil) -> XPCCallBatcher<Recorder> {
+        XPCCallBatcher(interval: interval, queue: queue) { [recorder] calls in
+            recorder.values.removeAll()
+            for call in calls {
+                call(recorder)
+            }
+            self.batches.append(recorder.values)
+            expectation?.fulfill()
+        }
+    }
+
+    private func record(_ value: String) -> (Recorder) -> Void {
+        { $0.values.append(value) }
+    }
+
+    func testWhenCallsHaveNoCoalescingKeyThenAllCallsAreFlushedInOrder() {
+        let batcher = makeBatcher(interval: .seconds(60))
+
+        for index in 0..<100 {
+            batcher.enqueue(coalescingKey: nil, call: record("\(index)"))
+        }
+        batcher.flush()
+        queue.sync {}
+
+        XCTAssertEqual(batches, [(0..<100).map { "\($0)" }])
+    }
+
+    func testWhenCallsShareCoalescingKeyThenOnlyLatestCallIsFlushed() {
+        let batcher = makeBatcher(interval: .seconds(60))
+
+        batcher.enqueue(coalescingKey: "status", call: record("status 1"))
+        batcher.enqueue(coalescingKey: nil, call: record("event 1"))
+        batcher.enqueue(coalescingKey: "progress", call: record("progress 1"))
+        batcher.enqueue(coalescingKey: "status", call: record("status 2"))
+        batcher.enqueue(coalescingKey: nil, call: record("event 2"))
+        batcher.enqueue(coalescingKey: "progress", call: record("progress 2"))
+        batcher.enqueue(coalescingKey: "status", call: record("status 3"))
+        batcher.flush()
+
+        // keys are forgotten once flushed
+        batcher.enqueue(coalescingKey: "status", call: record("status 4"))
+        batcher.enqueue(coalescingKey: nil, call: record("event 3"))
+        batcher.flush()
+        queue.sync {}
+
+        XCTAssertEqual(batches, [
+            ["event 1", "event 2", "progress 2", "status 3"],
+            ["status 4", "event 3"]
+        ])
+    }
+
+    func testWhenCallsAreEnqueuedThenTheyAreFlushedTogetherAfterInterval() {
+        let interval = 0.2
+        let flushed = expectation(description: "flushed")
+        let batcher = makeBatcher(interval: .milliseconds(Int(interval * 1000)), expectation: flushed)
+        let start = Date()
+
+        batcher.enqueue(coalescingKey: nil, call: record("a"))
+        batcher.enqueue(coalescingKey: nil, call: record("b"))
+        batcher.enqueue(coalescingKey: nil, call: record("c"))
+        queue.sync {}
+        XCTAssertTrue(batches.isEmpty)
+
+        wait(for: [flushed], timeout: 5)
+        XCTAssertGreaterThanOrEqual(Date().timeIntervalSince(start), interval)
+        XCTAssertEqual(batches, [["a", "b", "c"]])
+    }
+
+    func testWhenCallsAreEnqueuedAfterFlushThenNewFlushIsScheduled() {
+        let firstFlush = expectation(description: "first flush")
+        let secondFlush = expectation(description: "second flush")
+        var flushExpectations = [firstFlush, secondFlush]
+        let batcher = XPCCallBatcher<Recorder>(interval: .milliseconds(50), queue: queue) { [recorder] calls in
+            recorder.values.removeAll()
+            calls.forEach { $0(recorder) }
+            self.batches.append(recorder.values)
+            flushExpectations.removeFirst().fulfill()
+        }
+
+        batcher.enqueue(coalescingKey: "progress", call: record("progress 1"))
+        wait(for: [firstFlush], timeout: 5)
+        batcher.enqueue(coalescingKey: "progress", call: record("progress 2"))
+        wait(for: [secondFlush], timeout: 5)
+
+        XCTAssertEqual(batches, [["progress 1"], ["progress 2"]])
+    }
+
+    func testWhenNothingIsPendingThenFlushDoesNotCallHandler() {
+        let batcher = makeBatcher(interval: .seconds(60))
+
+        batcher.flush()
+        queue.sync {}
+
+        XCTAssertTrue(batches.isEmpty)
+    }
+}
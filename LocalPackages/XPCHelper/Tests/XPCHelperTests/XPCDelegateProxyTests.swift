@@ -0,0 +1,123 @@
+//
+//  XPCDelegateProxyTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import XCTest
+import XPCDelegateProxy
+
+@objc private protocol TestDelegate {
+    func value(for input: Int) -> Int
+    func record()
+}
+
+private class Delegate: NSObject, TestDelegate {
+    @objc dynamic var observedValue = 0
+    var recordCount = 0
+
+    func value(for input: Int) -> Int {
+        input * 2
+    }
+
+    func record() {
+        recordCount += 1
+    }
+}
+
+/// Answers `respondsToSelector:` per instance, so its lookups must not be cached for the class.
+private final class SelectiveDelegate: Delegate {
+    var respondsToRecord: Bool
+
+    init(respondsToRecord: Bool) {
+        self.respondsToRecord = respondsToRecord
+    }
+
+    override func responds(to aSelector: Selector!) -> Bool {
+        guard aSelector == #selector(TestDelegate.record) else { return super.responds(to: aSelector) }
+        return respondsToRecord
+    }
+}
+
+final class XPCDelegateProxyTests: XCTestCase {
+
+    private func proxy(for delegate: Delegate) -> (proxy: XPCDelegateProxy, delegate: TestDelegate) {
+        let proxy = XPCDelegateProxy(delegate: delegate)
+        return (proxy, unsafeBitCast(proxy, to: TestDelegate.self))
+    }
+
+    func testWhenDelegateImplementsMethodThenMessagesAreForwardedWithArgumentsAndReturnValues() {
+        let delegates = [Delegate(), Delegate()]
+
+        // lookups are cached after the first message, and shared by the instances of the class
+        for delegate in delegates {
+            let (proxy, proxiedDelegate) = proxy(for: delegate)
+            for input in 0..<10 {
+                XCTAssertEqual(proxiedDelegate.value(for: input), input * 2)
+            }
+            proxiedDelegate.record()
+            XCTAssertEqual(delegate.recordCount, 1)
+            withExtendedLifetime(proxy) {}
+        }
+    }
+
+    func testWhenInstancesOfClassRespondDifferentlyThenEachInstanceIsAsked() {
+        let respondingDelegate = SelectiveDelegate(respondsToRecord: true)
+        let silentDelegate = SelectiveDelegate(respondsToRecord: false)
+        let (respondingProxy, proxiedRespondingDelegate) = proxy(for: respondingDelegate)
+        let (silentProxy, proxiedSilentDelegate) = proxy(for: silentDelegate)
+
+        proxiedRespondingDelegate.record()
+        proxiedSilentDelegate.record()
+        XCTAssertEqual(respondingDelegate.recordCount, 1)
+        XCTAssertEqual(silentDelegate.recordCount, 0)
+
+        // the answer may change over time too
+        silentDelegate.respondsToRecord = true
+        respondingDelegate.respondsToRecord = false
+        proxiedRespondingDelegate.record()
+        proxiedSilentDelegate.record()
+        XCTAssertEqual(respondingDelegate.recordCount, 1)
+        XCTAssertEqual(silentDelegate.recordCount, 1)
+
+        withExtendedLifetime((respondingProxy, silentProxy)) {}
+    }
+
+    func testWhenDelegateIsObservedThenMessagesAreForwarded() {
+        let delegate = Delegate()
+        let observation = delegate.observe(\.observedValue) { _, _ in }
+        let (proxy, proxiedDelegate) = proxy(for: delegate)
+
+        XCTAssertEqual(proxiedDelegate.value(for: 21), 42)
+        proxiedDelegate.record()
+        XCTAssertEqual(delegate.recordCount, 1)
+
+        withExtendedLifetime((proxy, observation)) {}
+    }
+
+    func testWhenDelegateIsChangedThenMessagesAreForwardedToNewDelegate() {
+        let firstDelegate = Delegate()
+        let secondDelegate = Delegate()
+        let (proxy, proxiedDelegate) = proxy(for: firstDelegate)
+
+        proxiedDelegate.record()
+        proxy.delegate = secondDelegate
+        proxiedDelegate.record()
+
+        XCTAssertEqual(firstDelegate.recordCount, 1)
+        XCTAssertEqual(secondDelegate.recordCount, 1)
+    }
+}
@@ -9,9 +9,15 @@
 #import "PFMoveApplication.h"
 
 #import <AppKit/AppKit.h>
+#import <CommonCrypto/CommonDigest.h>
 #import <Security/Security.h>
+#import <copyfile.h>
 #import <dlfcn.h>
+#import <fts.h>
+#import <stdatomic.h>
+#import <sys/clonefile.h>
 #import <sys/mount.h>
+#import <sys/stat.h>
 
 @interface LetsMove : NSObject
 @end
@@ -53,6 +59,9 @@ static BOOL Trash(NSString *path);
 static BOOL DeleteOrTrash(NSString *path);
 static BOOL AuthorizedInstall(NSString *srcPath, NSString *dstPath, BOOL *canceled);
 static BOOL CopyBundle(NSString *srcPath, NSString *dstPath);
+static BOOL CopyBundleTree(NSString *srcPath, NSString *dstPath);
+static BOOL CopyBundleFile(const char *src, const char *dst, BOOL isSymbolicLink);
+static BOOL FileContentsEqual(const char *path1, const char *path2, off_t size);
 static NSString *ShellQuotedString(NSString *string);
 static void Relaunch(NSString *destinationPath);
 
@@ -450,16 +459,166 @@ fail:
 }
 
 static BOOL CopyBundle(NSString *srcPath, NSString *dstPath) {
-	NSFileManager *fm = [NSFileManager defaultManager];
-	NSError *error = nil;
+	// Same APFS volume: clone the whole bundle at once. This is nearly instant and preserves
+	// permissions, xattrs and ACLs.
+	if (clonefile([srcPath fileSystemRepresentation], [dstPath fileSystemRepresentation], CLONE_NOFOLLOW) == 0) {
+		return YES;
+	}
+	if (errno == EEXIST) {
+		NSLog(@"ERROR -- Could not copy '%@' to '%@' (%s)", srcPath, dstPath, strerror(errno));
+		return NO;
+	}
+	// Clean up a partially cloned bundle if any
+	[[NSFileManager defaultManager] removeItemAtPath:dstPath error:NULL];
 
-	if ([fm copyItemAtPath:srcPath toPath:dstPath error:&error]) {
+	if (CopyBundleTree(srcPath, dstPath)) {
 		return YES;
 	}
 	else {
-		NSLog(@"ERROR -- Could not copy '%@' to '%@' (%@)", srcPath, dstPath, error);
+		NSLog(@"ERROR -- Could not copy '%@' to '%@'", srcPath, dstPath);
+		[[NSFileManager defaultManager] removeItemAtPath:dstPath error:NULL];
+		return NO;
+	}
+}
+
+// Copies the bundle file by file (e.g. from a disk image): the directories are created while walking the tree,
+// then the files are copied concurrently and the directory attributes are applied last (so read-only
+// directories can still be populated).
+static BOOL CopyBundleTree(NSString *srcPath, NSString *dstPath) {
+	NSMutableArray *directories = [NSMutableArray array];
+	NSMutableArray *files = [NSMutableArray array];
+	NSMutableArray *symbolicLinks = [NSMutableArray array];
+	NSUInteger srcPathLength = strlen([srcPath fileSystemRepresentation]);
+
+	char *ftsPaths[] = {(char *)[srcPath fileSystemRepresentation], NULL};
+	FTS *fts = fts_open(ftsPaths, FTS_PHYSICAL | FTS_NOCHDIR, NULL);
+	if (!fts) return NO;
+
+	BOOL result = YES;
+	FTSENT *entry;
+	while (result && (entry = fts_read(fts)) != NULL) {
+		const char *relativePathRepresentation = entry->fts_path + srcPathLength;
+		NSString *relativePath = [[NSFileManager defaultManager] stringWithFileSystemRepresentation:relativePathRepresentation
+																							length:strlen(relativePathRepresentation)];
+		NSString *dstEntryPath = [dstPath stringByAppendingString:relativePath];
+
+		switch (entry->fts_info) {
+			case FTS_D:
+				if (mkdir([dstEntryPath fileSystemRepresentation], S_IRWXU) != 0) {
+					NSLog(@"ERROR -- Could not create directory '%@' (%s)", dstEntryPath, strerror(errno));
+					result = NO;
+				}
+				[directories addObject:relativePath];
+				break;
+			case FTS_F:
+				[files addObject:relativePath];
+				break;
+			case FTS_SL:
+			case FTS_SLNONE:
+				[symbolicLinks addObject:relativePath];
+				break;
+			case FTS_DP:
+				break;
+			default:
+				NSLog(@"ERROR -- Could not read '%s' (%s)", entry->fts_path, strerror(entry->fts_errno));
+				result = NO;
+				break;
+		}
+	}
+	fts_close(fts);
+	if (!result) return NO;
+
+	NSArray *entries = [files arrayByAddingObjectsFromArray:symbolicLinks];
+	NSUInteger symbolicLinksStart = [files count];
+	atomic_bool failed = false;
+	atomic_bool *failedRef = &failed;
+	dispatch_apply([entries count], DISPATCH_APPLY_AUTO, ^(size_t idx) {
+		if (atomic_load(failedRef)) return;
+
+		@autoreleasepool {
+			NSString *relativePath = [entries objectAtIndex:idx];
+			const char *src = [[srcPath stringByAppendingString:relativePath] fileSystemRepresentation];
+			const char *dst = [[dstPath stringByAppendingString:relativePath] fileSystemRepresentation];
+
+			if (!CopyBundleFile(src, dst, idx >= symbolicLinksStart)) {
+				atomic_store(failedRef, true);
+			}
+		}
+	});
+	if (atomic_load(&failed)) return NO;
+
+	// Children first: a read-only parent directory can still get its children attributes set
+	for (NSString *relativePath in [directories reverseObjectEnumerator]) {
+		const char *src = [[srcPath stringByAppendingString:relativePath] fileSystemRepresentation];
+		const char *dst = [[dstPath stringByAppendingString:relativePath] fileSystemRepresentation];
+
+		if (copyfile(src, dst, NULL, COPYFILE_METADATA | COPYFILE_STAT | COPYFILE_NOFOLLOW) != 0) {
+			NSLog(@"ERROR -- Could not copy attributes of '%s' (%s)", src, strerror(errno));
+			return NO;
+		}
+	}
+
+	return YES;
+}
+
+static BOOL CopyBundleFile(const char *src, const char *dst, BOOL isSymbolicLink) {
+	// A clone shares the source blocks and keeps all the attributes: there is nothing to verify
+	if (!isSymbolicLink && clonefile(src, dst, CLONE_NOFOLLOW) == 0) {
+		return YES;
+	}
+
+	if (copyfile(src, dst, NULL, COPYFILE_ALL | COPYFILE_NOFOLLOW) != 0) {
+		NSLog(@"ERROR -- Could not copy '%s' (%s)", src, strerror(errno));
 		return NO;
 	}
+	if (isSymbolicLink) return YES;
+
+	// Verify the copied data
+	struct stat srcStat, dstStat;
+	if (lstat(src, &srcStat) != 0 || lstat(dst, &dstStat) != 0 || srcStat.st_size != dstStat.st_size) {
+		NSLog(@"ERROR -- Size mismatch after copying '%s'", src);
+		return NO;
+	}
+	if (!FileContentsEqual(src, dst, srcStat.st_size)) {
+		NSLog(@"ERROR -- Checksum mismatch after copying '%s'", src);
+		return NO;
+	}
+
+	return YES;
+}
+
+static BOOL FileContentsEqual(const char *path1, const char *path2, off_t size) {
+	if (size == 0) return YES;
+
+	const char *paths[] = {path1, path2};
+	unsigned char digests[2][CC_SHA256_DIGEST_LENGTH];
+	const size_t bufferSize = 1 << 20;
+	void *buffer = malloc(bufferSize);
+	if (!buffer) return NO;
+
+	BOOL result = YES;
+	for (int i = 0; result && i < 2; i++) {
+		int fd = open(paths[i], O_RDONLY);
+		if (fd < 0) {
+			result = NO;
+			break;
+		}
+		// the data is read once: don't keep it in the cache
+		fcntl(fd, F_NOCACHE, 1);
+
+		CC_SHA256_CTX context;
+		CC_SHA256_Init(&context);
+		ssize_t bytesRead;
+		while ((bytesRead = read(fd, buffer, bufferSize)) > 0) {
+			CC_SHA256_Update(&context, buffer, (CC_LONG)bytesRead);
+		}
+		if (bytesRead < 0) result = NO;
+		CC_SHA256_Final(digests[i], &context);
+		close(fd);
+	}
+	free(buffer);
+
+	return result && memcmp(digests[0], digests[1], CC_SHA256_DIGEST_LENGTH) == 0;
 }
 
 static NSString *ShellQuotedString(NSString *string) {
@@ -55,4 +55,17 @@ final class ArrayExtensionTests: XCTestCase {
         XCTAssertEqual([1, 2, 3].chunk(with: 100, offset: 2), [3])
         XCTAssertEqual([1, 2, 3, 4, 5, 6].chunk(with: 4, offset: 4), [5, 6])
     }
+
+    // MARK: - concurrentMap
+
+    func testThatConcurrentMapKeepsOrderOfElements() {
+        let array = Array(0..<1000)
+        XCTAssertEqual(array.concurrentMap(chunkSize: 7) { $0 * 2 }, array.map { $0 * 2 })
+        XCTAssertEqual(array.concurrentMap { String($0) }, array.map { String($0) })
+    }
+
+    func testThatConcurrentMapOfArrayShorterThanChunkReturnsMappedArray() {
+        XCTAssertEqual([Int]().concurrentMap { $0 + 1 }, [])
+        XCTAssertEqual([1, 2, 3].concurrentMap(chunkSize: 3) { $0 + 1 }, [2, 3, 4])
+    }
 }
@@ -0,0 +1,140 @@
+//
+//  NSObjectPerformSelectorTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class NSObjectPerformSelectorTests: XCTestCase {
+
+    private final class Target: NSObject {
+        var receivedObject: Any?
+
+        @objc func store(_ object: Any?) {
+            receivedObject = object
+        }
+
+        @objc func echo(_ string: NSString) -> NSString {
+            string
+        }
+
+        @objc func sum(_ a: Int, _ b: Int32, _ c: UInt8) -> Int {
+            a + Int(b) + Int(c)
+        }
+
+        @objc func half(_ value: Double, _ other: Float) -> Double {
+            value / 2 + Double(other)
+        }
+
+        @objc func negate(_ flag: Bool) -> Bool {
+            !flag
+        }
+
+        @objc func offset(_ rect: NSRect, by point: NSPoint) -> NSRect {
+            rect.offsetBy(dx: point.x, dy: point.y)
+        }
+
+        @objc func isNull(_ pointer: UnsafeMutableRawPointer?) -> Bool {
+            pointer == nil
+        }
+
+        @objc func address(of rect: UnsafeMutablePointer<NSRect>?) -> Int {
+            Int(bitPattern: rect)
+        }
+    }
+
+    func testWhenMethodTakesObjectThenObjectIsPassedAndReturned() {
+        let target = Target()
+        XCTAssertEqual(target.perform(#selector(Target.echo(_:)), withArguments: ["hello"]) as? String, "hello")
+    }
+
+    func testWhenArgumentIsNSNullThenNilIsPassed() {
+        let target = Target()
+        target.receivedObject = "not nil"
+
+        XCTAssertNil(target.perform(#selector(Target.store(_:)), withArguments: [NSNull()]))
+        XCTAssertNil(target.receivedObject)
+    }
+
+    func testWhenMethodTakesIntegersThenNumbersAreConverted() {
+        let target = Target()
+        let result = target.perform(#selector(Target.sum(_:_:_:)), withArguments: [NSNumber(value: 40), NSNumber(value: 1), NSNumber(value: 1)])
+        XCTAssertEqual(result as? Int, 42)
+    }
+
+    func testWhenMethodTakesFloatingPointValuesThenNumbersAreConverted() {
+        let target = Target()
+        let result = target.perform(#selector(Target.half(_:_:)), withArguments: [NSNumber(value: 5.0), NSNumber(value: Float(0.25))])
+        XCTAssertEqual(result as? Double, 2.75)
+    }
+
+    func testWhenMethodTakesBoolThenBoolIsConvertedAndReturned() {
+        let target = Target()
+        XCTAssertEqual(target.perform(#selector(Target.negate(_:)), withArguments: [NSNumber(value: false)]) as? Bool, true)
+        XCTAssertEqual(target.perform(#selector(Target.negate(_:)), withArguments: [NSNumber(value: true)]) as? Bool, false)
+    }
+
+    func testWhenMethodTakesStructsThenValuesAreUnboxedAndReturnValueIsBoxed() {
+        let target = Target()
+        let result = target.perform(#selector(Target.offset(_:by:)), withArguments: [NSValue(rect: NSRect(x: 1, y: 2, width: 3, height: 4)),
+                                                                                      NSValue(point: NSPoint(x: 10, y: 20))])
+        XCTAssertEqual((result as? NSValue)?.rectValue, NSRect(x: 11, y: 22, width: 3, height: 4))
+    }
+
+    func testWhenMethodTakesPointerThenPointerValueIsPassed() {
+        let target = Target()
+        XCTAssertEqual(target.perform(#selector(Target.isNull(_:)), withArguments: [NSValue(pointer: nil)]) as? Bool, true)
+        XCTAssertEqual(target.perform(#selector(Target.isNull(_:)), withArguments: [NSValue(pointer: UnsafeRawPointer(bitPattern: 0x10))]) as? Bool, false)
+    }
+
+    func testWhenMethodTakesTypedPointerThenOnlyValueOfMatchingTypeIsUnboxed() throws {
+        let target = Target()
+        let selector = #selector(Target.address(of:))
+
+        // untyped pointer values aren't unboxed for typed pointers: the argument receives the object pointer, as in WebViewContainerView
+        let voidPointerValue = NSValue(pointer: nil)
+        XCTAssertEqual(target.perform(selector, withArguments: [voidPointerValue]) as? Int, Int(bitPattern: Unmanaged.passUnretained(voidPointerValue).toOpaque()))
+
+        let method = try XCTUnwrap(class_getInstanceMethod(Target.self, selector))
+        let argumentType = try XCTUnwrap(method_copyArgumentType(method, 2))
+        defer { free(argumentType) }
+        var pointer = UnsafeMutableRawPointer(bitPattern: 0x10)
+        let typedPointerValue = NSValue(bytes: &pointer, objCType: argumentType)
+        XCTAssertEqual(target.perform(selector, withArguments: [typedPointerValue]) as? Int, 0x10)
+    }
+
+    func testWhenArgumentsAreMissingThenTheyAreZeroFilled() {
+        let target = Target()
+        XCTAssertEqual(target.perform(#selector(Target.sum(_:_:_:)), withArguments: [NSNumber(value: 7)]) as? Int, 7)
+    }
+
+    func testWhenSelectorIsPerformedRepeatedlyThenResultsAreConsistent() {
+        let target = Target()
+        for i in 0..<100 {
+            let result = target.perform(#selector(Target.sum(_:_:_:)), withArguments: [NSNumber(value: i), NSNumber(value: 1), NSNumber(value: 0)])
+            XCTAssertEqual(result as? Int, i + 1)
+        }
+    }
+
+    func testWhenSelectorIsNotImplementedThenExceptionIsRaised() {
+        let target = Target()
+        XCTAssertThrowsError(try NSException.catch {
+            target.perform(NSSelectorFromString("notImplemented:"), withArguments: [])
+        })
+    }
+
+}
@@ -71,6 +71,11 @@ final class FileStoreMock: NSObject, FileStore {
         return true
     }
 
+    var encryptImpl: (Data) -> Data? = { $0 }
+    func encrypt(_ data: Data) -> Data? {
+        encryptImpl(data)
+    }
+
     var decryptImpl: (Data) -> Data? = { $0 }
     func decrypt(_ data: Data) -> Data? {
         decryptImpl(data)
@@ -0,0 +1,238 @@
+//
+//  SessionStateChunkStoreTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class SessionStateChunkStoreTests: XCTestCase {
+
+    private var fileStore: FileStoreMock!
+    private let testFileName = "TestFile"
+    private let chunksDirectoryName = "TestFile.chunks"
+    private var chunkStore: SessionStateChunkStore!
+
+    override func setUp() {
+        fileStore = FileStoreMock()
+        chunkStore = SessionStateChunkStore(fileStore: fileStore, directoryName: chunksDirectoryName)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: URL.persistenceLocation(for: chunksDirectoryName))
+        chunkStore = nil
+        fileStore = nil
+    }
+
+    private func blob(_ seed: UInt8, count: Int = 10_000) -> Data {
+        Data((0..<count).map { UInt8(truncatingIfNeeded: $0 / 100) &+ seed })
+    }
+
+    func testWhenChunksArePersistedThenTheyAreCompressedAndCanBeLoaded() {
+        let data = blob(1)
+        let key = SessionStateChunkStore.key(for: data)
+
+        XCTAssertTrue(chunkStore.persist([key: data]))
+
+        XCTAssertLessThan(fileStore.storage[key]!.count, data.count)
+        XCTAssertEqual(chunkStore.loadChunk(forKey: key), data)
+    }
+
+    func testWhenChunkIsAlreadyPersistedThenItIsNotRewritten() {
+        let data1 = blob(1)
+        let data2 = blob(2)
+        let key1 = SessionStateChunkStore.key(for: data1)
+        let key2 = SessionStateChunkStore.key(for: data2)
+        XCTAssertTrue(chunkStore.persist([key1: data1]))
+        let marker = "persisted".utf8data
+        fileStore.storage[key1] = marker
+
+        XCTAssertTrue(chunkStore.persist([key1: data1, key2: data2]))
+
+        XCTAssertEqual(fileStore.storage[key1], marker)
+        XCTAssertEqual(chunkStore.loadChunk(forKey: key2), data2)
+    }
+
+    func testWhenChunksAreCompactedThenUnreferencedChunksAreRemoved() {
+        let chunks = [blob(1), blob(2), blob(3)].reduce(into: [String: Data]()) {
+            $0[SessionStateChunkStore.key(for: $1)] = $1
+        }
+        XCTAssertTrue(chunkStore.persist(chunks))
+        fileStore.directoryStorage[URL.persistenceLocation(for: chunksDirectoryName).path] = Array(chunks.keys)
+        let referencedKey = chunks.keys.first!
+
+        chunkStore.removeChunks(notIn: [referencedKey])
+
+        XCTAssertEqual(Set(fileStore.storage.keys), [referencedKey])
+    }
+
+    @MainActor
+    func testWhenStateWithChunksIsPersistedThenOnlyChunkKeysAreArchivedAndChunksAreRestored() throws {
+        let state = ChunkedStateMock(blobs: [blob(1), blob(2)])
+        let service = StatePersistenceService(fileStore: fileStore, fileName: testFileName)
+
+        service.persistState(using: state.encode(with:), sync: true)
+
+        let archive = try XCTUnwrap(fileStore.storage[testFileName])
+        XCTAssertLessThan(archive.count, 10_000)
+        XCTAssertEqual(SessionStateUnarchiver.chunkKeys(in: archive), Set(state.blobs.map(SessionStateChunkStore.key(for:))))
+
+        let restoredState = ChunkedStateMock(blobs: [])
+        try StatePersistenceService(fileStore: fileStore, fileName: testFileName).restoreState(using: restoredState.restoreState(from:))
+        XCTAssertEqual(restoredState.blobs, state.blobs)
+    }
+
+    @MainActor
+    func testWhenStateIsClearedWhileRestoredTabIsPendingThenItsChunkIsKept() throws {
+        let burnedBlob = blob(1)
+        let pendingBlob = blob(2)
+        let burnedKey = SessionStateChunkStore.key(for: burnedBlob)
+        let pendingKey = SessionStateChunkStore.key(for: pendingBlob)
+        StatePersistenceService(fileStore: fileStore, fileName: testFileName)
+            .persistState(using: ChunkedStateMock(blobs: [burnedBlob, pendingBlob]).encode(with:), sync: true)
+        fileStore.directoryStorage[URL.persistenceLocation(for: chunksDirectoryName).path] = [burnedKey, pendingKey]
+
+        // restored tabs keep referencing their chunks until they‘re displayed
+        let service = StatePersistenceService(fileStore: fileStore, fileName: testFileName)
+        service.loadLastSessionState()
+        let restoredState = PendingChunksStateMock()
+        try service.restoreState(using: restoredState.restoreState(from:))
+
+        // burning a domain clears the last session state
+        service.clearState(keepingChunks: [pendingKey], sync: true)
+
+        XCTAssertNil(fileStore.storage[testFileName])
+        XCTAssertNil(fileStore.storage[burnedKey])
+        XCTAssertNotNil(fileStore.storage[pendingKey])
+
+        // the burned tab is closed, the pending one is persisted without being loaded
+        restoredState.chunks.removeFirst()
+        service.persistState(using: restoredState.encode(with:), sync: true)
+
+        let relaunchedState = ChunkedStateMock(blobs: [])
+        try StatePersistenceService(fileStore: fileStore, fileName: testFileName).restoreState(using: relaunchedState.restoreState(from:))
+        XCTAssertEqual(relaunchedState.blobs, [pendingBlob])
+    }
+
+    func testWhenChunkIsDecodedThenItIsLoadedOnFirstAccessOnly() throws {
+        let data = blob(1)
+        let archiver = SessionStateArchiver(requiringSecureCoding: true)
+        archiver.encodeChunk(data, forKey: "blob")
+        archiver.encodeChunkKeys()
+
+        var loadedKeys = [String]()
+        let unarchiver = try SessionStateUnarchiver(forReadingFrom: archiver.encodedData)
+        unarchiver.chunkLoader = { key in
+            loadedKeys.append(key)
+            return data
+        }
+        let chunk = try XCTUnwrap(unarchiver.decodeChunk(forKey: "blob"))
+        XCTAssertEqual(loadedKeys, [])
+
+        XCTAssertEqual(chunk.data, data)
+        XCTAssertEqual(chunk.data, data)
+        XCTAssertEqual(loadedKeys, [SessionStateChunkStore.key(for: data)])
+    }
+
+    func testWhenChunksArePrefetchedThenMostRecentlyUsedChunksAreLoaded() throws {
+        let archiver = SessionStateArchiver(requiringSecureCoding: true)
+        for idx in 0..<4 {
+            archiver.encodeChunk(blob(UInt8(idx)), forKey: "blob\(idx)")
+        }
+        archiver.encodeChunkKeys()
+
+        let lock = NSLock()
+        var loadedKeys = Set<String>()
+        let unarchiver = try SessionStateUnarchiver(forReadingFrom: archiver.encodedData)
+        unarchiver.chunkLoader = { key in
+            lock.withLock { _=loadedKeys.insert(key) }
+            return Data()
+        }
+        let now = Date()
+        let priorities = [now.addingTimeInterval(-30), now, nil, now.addingTimeInterval(-10)]
+        for (idx, priority) in priorities.enumerated() {
+            _=unarchiver.decodeChunk(forKey: "blob\(idx)", prefetchPriority: priority)
+        }
+
+        let queue = DispatchQueue(label: "prefetch")
+        unarchiver.prefetchChunks(limit: 2, on: queue)
+        queue.sync {}
+
+        XCTAssertEqual(loadedKeys, [SessionStateChunkStore.key(for: blob(1)), SessionStateChunkStore.key(for: blob(3))])
+    }
+
+    func testWhenPersistedChunkIsReferencedThenItIsNotLoadedOrRewritten() {
+        let chunk = SessionStateChunk(key: "key") { _ in
+            XCTFail("Unexpected chunk load")
+            return nil
+        }
+        let archiver = SessionStateArchiver(requiringSecureCoding: true)
+        archiver.encodeChunk(chunk, forKey: "blob")
+
+        XCTAssertTrue(archiver.chunks.isEmpty)
+        XCTAssertEqual(archiver.referencedChunkKeys, ["key"])
+    }
+
+    @MainActor
+    func testWhenArchiveIsNotChunkedThenChunkKeysAreEmpty() throws {
+        let archiver = NSKeyedArchiver(requiringSecureCoding: true)
+        archiver.encode("value", forKey: "key")
+
+        XCTAssertEqual(SessionStateUnarchiver.chunkKeys(in: archiver.encodedData), [])
+    }
+
+}
+
+private final class ChunkedStateMock {
+
+    private(set) var blobs: [Data]
+
+    init(blobs: [Data]) {
+        self.blobs = blobs
+    }
+
+    func encode(with coder: NSCoder) {
+        coder.encode(blobs.count, forKey: "count")
+        for (idx, blob) in blobs.enumerated() {
+            (coder as! SessionStateArchiver).encodeChunk(blob, forKey: "blob\(idx)")
+        }
+    }
+
+    func restoreState(from coder: NSCoder) throws {
+        let count = coder.decodeInteger(forKey: "count")
+        blobs = (0..<count).compactMap { (coder as! SessionStateUnarchiver).decodeChunk(forKey: "blob\($0)")?.data }
+    }
+
+}
+
+/// State referencing the restored chunks without loading them, like the Tabs not displayed yet.
+private final class PendingChunksStateMock {
+
+    var chunks = [SessionStateChunk]()
+
+    func encode(with coder: NSCoder) {
+        coder.encode(chunks.count, forKey: "count")
+        for (idx, chunk) in chunks.enumerated() {
+            (coder as! SessionStateArchiver).encodeChunk(chunk, forKey: "blob\(idx)")
+        }
+    }
+
+    func restoreState(from coder: NSCoder) throws {
+        let count = coder.decodeInteger(forKey: "count")
+        chunks = (0..<count).compactMap { (coder as! SessionStateUnarchiver).decodeChunk(forKey: "blob\($0)") }
+    }
+
+}
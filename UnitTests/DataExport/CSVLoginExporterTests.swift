@@ -23,18 +23,22 @@ import BrowserServicesKit
 
 class CSVLoginExporterTests: XCTestCase {
 
+    let tmpFile: URL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString + ".csv", isDirectory: false)
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: tmpFile)
+    }
+
     func testWhenExportingLogins_ThenLoginsArePersistedToDisk() throws {
-        let mockFileStore = FileStoreMock()
         let vault = try MockSecureVaultFactory.makeVault(reporter: nil)
 
         vault.addWebsiteCredentials(identifiers: [1])
 
-        let exporter = CSVLoginExporter(secureVault: vault, fileStore: mockFileStore)
+        let exporter = CSVLoginExporter(secureVault: vault)
 
-        let mockURL = URL(fileURLWithPath: "mock-url")
-        try? exporter.exportVaultLogins(to: mockURL)
+        try? exporter.exportVaultLogins(to: tmpFile)
 
-        let data = mockFileStore.loadData(at: mockURL)
+        let data = try? Data(contentsOf: tmpFile)
         XCTAssertNotNil(data)
 
         let expectedHeader = "\"title\",\"url\",\"username\",\"password\"\n"
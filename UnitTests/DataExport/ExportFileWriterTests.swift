@@ -0,0 +1,62 @@
+//
+//  ExportFileWriterTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class ExportFileWriterTests: XCTestCase {
+
+    let tmpFile: URL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString + ".txt", isDirectory: false)
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: tmpFile)
+    }
+
+    func testWhenWritesExceedBufferCapacityThenFileContainsAllWrites() throws {
+        let writer = try ExportFileWriter(url: tmpFile, bufferCapacity: 8)
+        let strings = ["abc", "defgh", "i", "a string longer than the buffer", "", "🦆 ü", "end"]
+
+        for string in strings {
+            try writer.write(string)
+        }
+        try writer.finish()
+
+        XCTAssertEqual(try String(contentsOf: tmpFile), strings.joined())
+    }
+
+    func testWhenWriterIsNotFinishedThenFileIsNotWritten() throws {
+        var writer: ExportFileWriter? = try ExportFileWriter(url: tmpFile, bufferCapacity: 8)
+        try writer?.write("a string longer than the buffer")
+        writer = nil
+
+        XCTAssertFalse(FileManager.default.fileExists(atPath: tmpFile.path))
+    }
+
+    func testWhenFileExistsThenItIsReplacedOnlyWhenWriterIsFinished() throws {
+        try "existing file".write(to: tmpFile, atomically: true, encoding: .utf8)
+
+        let writer = try ExportFileWriter(url: tmpFile, bufferCapacity: 8)
+        try writer.write("exported file")
+        XCTAssertEqual(try String(contentsOf: tmpFile), "existing file")
+
+        try writer.finish()
+        XCTAssertEqual(try String(contentsOf: tmpFile), "exported file")
+    }
+
+}
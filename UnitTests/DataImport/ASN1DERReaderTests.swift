@@ -0,0 +1,124 @@
+//
+//  ASN1DERReaderTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+@testable import DuckDuckGo_Privacy_Browser
+import XCTest
+
+final class ASN1DERReaderTests: XCTestCase {
+
+    // SEQUENCE { SEQUENCE { OID, SEQUENCE { OCTET STRING salt, INTEGER 10000, NULL } }, OCTET STRING ciphertext (200 bytes) }
+    private let encryptedData: Data = {
+        let parameters = Data([0x30, 0x0C, 0x04, 0x04, 0xAA, 0xBB, 0xCC, 0xDD, 0x02, 0x02, 0x27, 0x10, 0x05, 0x00])
+        let algorithm = Data([0x30, 0x15, 0x06, 0x05, 0x2A, 0x86, 0x48, 0x86, 0xF7]) + parameters
+        let ciphertext = Data([0x04, 0x81, 0xC8]) + Data(repeating: 0x42, count: 200)
+        let contents = algorithm + ciphertext
+        return Data([0x30, 0x81, UInt8(contents.count)]) + contents
+    }()
+
+    func testWhenReadingNestedElementsThenContentsAreSlicesOfTheData() throws {
+        var reader = ASN1DERReader(data: encryptedData)
+        var outer = try XCTUnwrap(reader.readSequence())
+        XCTAssertTrue(reader.isAtEnd)
+
+        var algorithm = try XCTUnwrap(outer.readSequence())
+        XCTAssertEqual(algorithm.readObjectIdentifier(), Data([0x2A, 0x86, 0x48, 0x86, 0xF7]))
+
+        var parameters = try XCTUnwrap(algorithm.readSequence())
+        let salt = try XCTUnwrap(parameters.readOctetString())
+        XCTAssertEqual(salt, Data([0xAA, 0xBB, 0xCC, 0xDD]))
+        XCTAssertEqual(salt.startIndex, 16)
+        XCTAssertEqual(parameters.readInteger(), 10000)
+        XCTAssertTrue(parameters.readNull())
+        XCTAssertTrue(parameters.isAtEnd)
+        XCTAssertTrue(algorithm.isAtEnd)
+
+        XCTAssertEqual(outer.readOctetString(), Data(repeating: 0x42, count: 200))
+        XCTAssertTrue(outer.isAtEnd)
+    }
+
+    func testWhenElementIsOfAnotherTypeThenReaderDoesNotMove() {
+        var reader = ASN1DERReader(data: Data([0x02, 0x01, 0x05, 0x04, 0x01, 0xFF]))
+
+        XCTAssertNil(reader.readOctetString())
+        XCTAssertNil(reader.readSequence())
+        XCTAssertFalse(reader.readNull())
+        XCTAssertEqual(reader.readInteger(), 5)
+        XCTAssertNil(reader.readInteger())
+        XCTAssertEqual(reader.readOctetString(), Data([0xFF]))
+        XCTAssertTrue(reader.isAtEnd)
+    }
+
+    func testWhenIntegerIsNegativeOrTooLargeThenItIsNotRead() {
+        var negative = ASN1DERReader(data: Data([0x02, 0x01, 0x80]))
+        XCTAssertNil(negative.readInteger())
+        XCTAssertEqual(negative.readIntegerBytes(), Data([0x80]))
+
+        var tooLarge = ASN1DERReader(data: Data([0x02, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00]))
+        XCTAssertNil(tooLarge.readInteger())
+
+        var leadingZero = ASN1DERReader(data: Data([0x02, 0x05, 0x00, 0xFF, 0xFF, 0xFF, 0xFF]))
+        XCTAssertEqual(leadingZero.readInteger(), 0xFFFFFFFF)
+    }
+
+    func testWhenLengthIsInvalidThenElementIsNotRead() {
+        let invalidElements = [
+            Data([0x04]), // no length
+            Data([0x04, 0x03, 0x01, 0x02]), // truncated contents
+            Data([0x04, 0x80]), // indefinite length
+            Data([0x04, 0x82, 0x01]), // truncated long form length
+            Data([0x04, 0x85, 0x01, 0x00, 0x00, 0x00, 0x00]), // length of more than 4 bytes
+            Data([0x04, 0x84, 0xFF, 0xFF, 0xFF, 0xFF]), // length past the end
+            Data([0x1F, 0x01, 0x00]) // high tag number
+        ]
+
+        for data in invalidElements {
+            var reader = ASN1DERReader(data: data)
+            XCTAssertNil(reader.readElement(), "\(data as NSData)")
+            XCTAssertFalse(reader.isAtEnd)
+        }
+    }
+
+    func testWhenDataIsMutatedThenReadsStayWithinTheData() {
+        var generator = SystemRandomNumberGenerator()
+
+        for _ in 0..<5000 {
+            var data = encryptedData
+            for _ in 0..<Int.random(in: 1...4, using: &generator) {
+                data[Int.random(in: 0..<data.count, using: &generator)] = UInt8.random(in: 0...UInt8.max, using: &generator)
+            }
+            data = data.prefix(Int.random(in: 0...data.count, using: &generator))
+
+            var readers = [ASN1DERReader(data: data)]
+            var elementCount = 0
+            while var reader = readers.popLast() {
+                while let (tag, contents) = reader.readElement() {
+                    XCTAssertGreaterThanOrEqual(contents.startIndex, data.startIndex)
+                    XCTAssertLessThanOrEqual(contents.endIndex, data.endIndex)
+
+                    elementCount += 1
+                    if tag == ASN1DERReader.Tag.sequence.rawValue {
+                        readers.append(ASN1DERReader(data: contents))
+                    }
+                }
+            }
+            XCTAssertLessThanOrEqual(elementCount, data.count / 2)
+        }
+    }
+
+}
@@ -0,0 +1,119 @@
+//
+//  BookmarkHTMLStreamReaderTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class BookmarkHTMLStreamReaderTests: XCTestCase {
+
+    let bookmarksHTMLReaderTestFilesURL = Bundle(for: BookmarkHTMLStreamReaderTests.self)
+        .resourceURL!
+        .appendingPathComponent("DataImportResources/TestBookmarksData")
+
+    private func read(_ html: String) throws -> BookmarkHTMLStreamReader.Document {
+        try BookmarkHTMLStreamReader.read(html.utf8data)
+    }
+
+    func testWhenFileIsExportedByBrowserThenItIsReadWithoutTidy() throws {
+        let exportedFiles = [
+            "bookmarks_brave.html", "bookmarks_chrome.html", "bookmarks_firefox.html", "bookmarks_safari.html", "bookmarks_vivaldi.html",
+            "bookmarks_ddg_android.html", "bookmarks_ddg_ios.html", "bookmarks_ddg_macos.html", "bookmarks_duckduckgo_ipad.html"
+        ]
+
+        for fileName in exportedFiles {
+            XCTAssertNoThrow(try BookmarkHTMLStreamReader.read(contentsOf: bookmarksHTMLReaderTestFilesURL.appendingPathComponent(fileName)), fileName)
+        }
+    }
+
+    func testWhenFileNeedsToBeRepairedThenItIsNotRead() {
+        // mismatched quotes, stray text, lists without paragraphs
+        let dirtyFiles = ["bookmarks_safari_tp_dirty.html", "bookmarks_firefox_dirty.html", "bookmarks_invalid.html"]
+
+        for fileName in dirtyFiles {
+            XCTAssertThrowsError(try BookmarkHTMLStreamReader.read(contentsOf: bookmarksHTMLReaderTestFilesURL.appendingPathComponent(fileName)), fileName)
+        }
+    }
+
+    func testWhenBookmarksAreInTopLevelListThenFoldersAndBookmarksAreRead() throws {
+        let document = try read("""
+        <!DOCTYPE NETSCAPE-Bookmark-file-1>
+        <META HTTP-EQUIV="Content-Type" CONTENT="text/html; charset=UTF-8">
+        <TITLE>Bookmarks</TITLE>
+        <H1>Bookmarks</H1>
+        <DL><p>
+            <DT><H3 ADD_DATE="1">Bar &amp; Co</H3>
+            <DL><p>
+                <DT><A HREF="https://example.com/?a=1&b=2&amp;c=3">Q&amp;A &#8211; &quot;Example&quot;</A>
+                <HR>
+                <DT><A HREF="http://bookmark.placeholder.url/">---</A>
+            </DL><p>
+            <DT><A HREF="https://duckduckgo.com" duckduckgo:favorite="true">DuckDuckGo</A>
+        </DL><p>
+        """)
+
+        XCTAssertEqual(document.rootListItems, [
+            .folder(name: "Bar & Co", children: [
+                .bookmark(name: "Q&A – \"Example\"", urlString: "https://example.com/?a=1&b=2&c=3", isDDGFavorite: false)
+            ]),
+            .bookmark(name: "DuckDuckGo", urlString: "https://duckduckgo.com", isDDGFavorite: true)
+        ])
+        XCTAssertEqual(document.topLevelItems, [])
+        XCTAssertFalse(document.isDDGBookmarksDocument)
+    }
+
+    func testWhenFoldersAreAtTopLevelThenTheyAreReadInSafariFormat() throws {
+        let document = try read("""
+        <HTML xmlns:duckduckgo="https://duckduckgo.com/bookmarks">
+        <DT><H3 FOLDED>Favorites</H3>
+        <DL><p>
+            <DT><A HREF="https://example.com">Example</A>
+        </DL><p>
+        <DT><A HREF="https://duckduckgo.com">DuckDuckGo</A>
+        </HTML>
+        """)
+
+        XCTAssertNil(document.rootListItems)
+        XCTAssertEqual(document.topLevelItems, [
+            .folder(name: "Favorites", children: [.bookmark(name: "Example", urlString: "https://example.com", isDDGFavorite: false)]),
+            .bookmark(name: "DuckDuckGo", urlString: "https://duckduckgo.com", isDDGFavorite: false)
+        ])
+        XCTAssertTrue(document.isDDGBookmarksDocument)
+    }
+
+    func testWhenMarkupCouldBeReadDifferentlyByTidyThenItIsNotRead() {
+        let unsupportedMarkup = [
+            // unknown entity
+            "<DL><p><DT><A HREF=\"https://example.com\">&eacute;</A></DL><p>",
+            // entity name without a semicolon
+            "<DL><p><DT><A HREF=\"https://example.com/?a=1&copy=2\">Example</A></DL><p>",
+            // whitespace to be collapsed
+            "<DL><p><DT><A HREF=\"https://example.com\">Exa\nmple</A></DL><p>",
+            // markup inside a bookmark name
+            "<DL><p><DT><A HREF=\"https://example.com\"><B>Example</B></A></DL><p>",
+            // folder name not followed by its list
+            "<DL><p><DT><H3>Folder</H3><DT><A HREF=\"https://example.com\">Example</A></DL><p>",
+            // unterminated list
+            "<DL><p><DT><A HREF=\"https://example.com\">Example</A>"
+        ]
+
+        for html in unsupportedMarkup {
+            XCTAssertThrowsError(try read(html), html)
+        }
+    }
+
+}
@@ -0,0 +1,58 @@
+//
+//  FaviconDomainIndexTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class FaviconDomainIndexTests: XCTestCase {
+
+    func testWhenHostHasSubdomainsThenParentDomainsExcludeTopLevelDomain() {
+        XCTAssertEqual(FaviconDomainIndex<Int>.domains(of: "a.b.example.com"), ["a.b.example.com", "b.example.com", "example.com"])
+        XCTAssertEqual(FaviconDomainIndex<Int>.domains(of: "example.com"), ["example.com"])
+        XCTAssertEqual(FaviconDomainIndex<Int>.domains(of: "localhost"), ["localhost"])
+    }
+
+    func testWhenKeysAreInsertedThenTheyAreFoundByHostAndParentDomains() {
+        var index = FaviconDomainIndex<Int>()
+        index.insert(1, host: "example.com")
+        index.insert(2, host: "www.example.com")
+        index.insert(3, host: "www.example.com")
+        index.insert(4, host: "notexample.com")
+
+        XCTAssertEqual(index.keys(forHost: "www.example.com"), [2, 3])
+        XCTAssertEqual(index.keys(forDomainOrAnySubdomain: "example.com"), [1, 2, 3])
+        XCTAssertEqual(index.keys(forDomainOrAnySubdomain: "www.example.com"), [2, 3])
+        XCTAssertEqual(index.keys(forDomainOrAnySubdomain: "duckduckgo.com"), [])
+        XCTAssertEqual(Set(index.hosts), ["example.com", "www.example.com", "notexample.com"])
+    }
+
+    func testWhenKeysAreRemovedThenEmptyPostingListsAreDropped() {
+        var index = FaviconDomainIndex<Int>()
+        index.insert(1, host: "example.com")
+        index.insert(2, host: "www.example.com")
+
+        index.remove(2, host: "www.example.com")
+        XCTAssertEqual(index.keys(forDomainOrAnySubdomain: "example.com"), [1])
+        XCTAssertEqual(Array(index.hosts), ["example.com"])
+
+        index.remove(1, host: "example.com")
+        XCTAssertTrue(index.isEmpty)
+        XCTAssertEqual(index.keys(forDomainOrAnySubdomain: "example.com"), [])
+    }
+
+}
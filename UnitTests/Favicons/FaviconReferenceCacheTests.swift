@@ -90,6 +90,22 @@ class FaviconReferenceCacheTests: XCTestCase {
         XCTAssertEqual(URL.aFaviconUrl1, referenceCache.getFaviconUrl(for: URL.aDocumentUrl1.host!, sizeCategory: .small))
         XCTAssertEqual(URL.aFaviconUrl1, referenceCache.getFaviconUrl(for: URL.aDocumentUrl2, sizeCategory: .small))
     }
+
+    @MainActor
+    func testWhenSubdomainHasHostReference_ThenItIsFoundForParentDomain() {
+        let referenceCache = FaviconReferenceCache(faviconStoring: FaviconStoringMock())
+        let loadingExpectation = expectation(description: "Loading")
+        referenceCache.loadReferences { _ in
+            loadingExpectation.fulfill()
+        }
+
+        waitForExpectations(timeout: 1, handler: nil)
+
+        referenceCache.insert(faviconUrls: (URL.aFaviconUrl1, URL.aFaviconUrl1), documentUrl: URL.aSubdomainDocumentUrl)
+        XCTAssertEqual(referenceCache.host(forDomainOrAnySubdomain: "fav.com"), URL.aSubdomainDocumentUrl.host)
+        XCTAssertEqual(referenceCache.host(forDomainOrAnySubdomain: URL.aSubdomainDocumentUrl.host!), URL.aSubdomainDocumentUrl.host)
+        XCTAssertNil(referenceCache.host(forDomainOrAnySubdomain: "av.com"))
+    }
 }
 
 private extension URL {
@@ -102,4 +118,6 @@ private extension URL {
 
     static let aDocumentUrl3 = URL(string: "https://duckduckgo.com/")!
 
+    static let aSubdomainDocumentUrl = URL(string: "https://www.fav.com/index.html")!
+
 }
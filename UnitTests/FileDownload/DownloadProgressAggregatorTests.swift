@@ -0,0 +1,119 @@
+//
+//  DownloadProgressAggregatorTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Combine
+import XCTest
+
+@testable import DuckDuckGo_Privacy_Browser
+
+@MainActor
+final class DownloadProgressAggregatorTests: XCTestCase {
+
+    var aggregator: DownloadProgressAggregator!
+    var cancellables = Set<AnyCancellable>()
+
+    override func setUp() {
+        aggregator = DownloadProgressAggregator(frequency: 1)
+    }
+
+    override func tearDown() {
+        cancellables.removeAll()
+        aggregator = nil
+    }
+
+    func testWhenProgressChangesMultipleTimesBetweenTicksThenOnlyLatestValueIsDelivered() {
+        let progress = Progress(totalUnitCount: 100)
+        var updates = [(Int64, Int64)]()
+        aggregator.subscribe(to: progress) { total, completed in
+            updates.append((total, completed))
+        }.store(in: &cancellables)
+
+        aggregator.tick()
+        progress.completedUnitCount = 10
+        progress.completedUnitCount = 20
+        progress.completedUnitCount = 30
+        aggregator.tick()
+        aggregator.tick()
+
+        XCTAssertEqual(updates.map { $0.0 }, [100, 100])
+        XCTAssertEqual(updates.map { $0.1 }, [0, 30])
+    }
+
+    func testWhenSubscriptionIsCancelledThenUpdatesAreNotDelivered() {
+        let progress = Progress(totalUnitCount: 100)
+        var updatesCount = 0
+        let cancellable = aggregator.subscribe(to: progress) { _, _ in
+            updatesCount += 1
+        }
+
+        aggregator.tick()
+        cancellable.cancel()
+        progress.completedUnitCount = 50
+        aggregator.tick()
+
+        XCTAssertEqual(updatesCount, 1)
+    }
+
+    func testWhenProgressesBelongToGroupsThenAggregatesAreComputedPerGroup() {
+        let progress1 = Progress(totalUnitCount: 100)
+        let progress2 = Progress(totalUnitCount: 300)
+        let progress3 = Progress(totalUnitCount: 1000)
+        let ungrouped = Progress(totalUnitCount: 50)
+        aggregator.subscribe(to: progress1, group: "a") { _, _ in }.store(in: &cancellables)
+        aggregator.subscribe(to: progress2, group: "a") { _, _ in }.store(in: &cancellables)
+        aggregator.subscribe(to: progress3, group: "b") { _, _ in }.store(in: &cancellables)
+        aggregator.subscribe(to: ungrouped) { _, _ in }.store(in: &cancellables)
+
+        progress1.completedUnitCount = 10
+        progress2.completedUnitCount = 20
+        aggregator.tick()
+
+        XCTAssertEqual(aggregator.aggregates.count, 2)
+        XCTAssertEqual(aggregator.aggregates["a"]?.totalUnitCount, 400)
+        XCTAssertEqual(aggregator.aggregates["a"]?.completedUnitCount, 30)
+        XCTAssertEqual(aggregator.aggregates["b"]?.totalUnitCount, 1000)
+        XCTAssertEqual(aggregator.aggregates["b"]?.completedUnitCount, 0)
+    }
+
+    func testWhenProgressAdvancesThenThroughputAndEstimatedTimeRemainingArePublished() {
+        let progress = Progress(totalUnitCount: 1000)
+        aggregator.subscribe(to: progress, group: "a") { _, _ in }.store(in: &cancellables)
+
+        let date = Date()
+        aggregator.tick(now: date)
+        XCTAssertNil(aggregator.aggregates["a"]?.throughput)
+
+        progress.completedUnitCount = 100
+        aggregator.tick(now: date.addingTimeInterval(1))
+
+        XCTAssertEqual(aggregator.aggregates["a"]?.throughput, 100)
+        XCTAssertEqual(aggregator.aggregates["a"]?.estimatedTimeRemaining, 9)
+    }
+
+    func testWhenLastGroupSubscriptionIsCancelledThenGroupAggregateIsRemoved() {
+        let progress = Progress(totalUnitCount: 100)
+        let cancellable = aggregator.subscribe(to: progress, group: "a") { _, _ in }
+        aggregator.tick()
+        XCTAssertNotNil(aggregator.aggregates["a"])
+
+        cancellable.cancel()
+
+        XCTAssertNil(aggregator.aggregates["a"])
+    }
+
+}
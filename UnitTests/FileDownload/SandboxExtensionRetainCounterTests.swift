@@ -0,0 +1,99 @@
+//
+//  SandboxExtensionRetainCounterTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class SandboxExtensionRetainCounterTests: XCTestCase {
+
+    func testWhenRetainCountIsAddedThenItIsTrackedPerURLInstance() {
+        let counter = SandboxExtensionRetainCounter()
+        let url1 = NSURL(fileURLWithPath: "/tmp/file")
+        let url2 = NSURL(fileURLWithPath: "/tmp/file")
+
+        XCTAssertEqual(counter.add(1, to: url1), 1)
+        XCTAssertEqual(counter.add(1, to: url1), 2)
+
+        XCTAssertEqual(counter.retainCount(for: url1), 2)
+        XCTAssertEqual(counter.retainCount(for: url2), 0)
+    }
+
+    func testWhenRetainCountIsDecrementedBelowZeroThenItStaysAtZero() {
+        let counter = SandboxExtensionRetainCounter()
+        let url = NSURL(fileURLWithPath: "/tmp/file")
+
+        counter.add(1, to: url)
+        XCTAssertEqual(counter.add(-1, to: url), 0)
+        XCTAssertEqual(counter.add(-1, to: url), 0)
+        XCTAssertEqual(counter.retainCount(for: url), 0)
+        XCTAssertTrue(counter.activeURLs().isEmpty)
+    }
+
+    func testWhenURLHasRetainCountThenItIsActive() {
+        let counter = SandboxExtensionRetainCounter()
+        let url = NSURL(fileURLWithPath: "/tmp/file")
+
+        counter.add(1, to: url)
+        XCTAssertTrue(counter.activeURLs().contains { $0 === url })
+
+        counter.add(-1, to: url)
+        XCTAssertFalse(counter.activeURLs().contains { $0 === url })
+    }
+
+    func testWhenURLIsDeallocatedWithUnbalancedAccessThenLeakIsReportedOnNextUpdateOfItsStripe() {
+        var leakedAccesses = [SandboxExtensionRetainCounter.LeakedAccess]()
+        let counter = SandboxExtensionRetainCounter(stripeCount: 1) { leakedAccesses.append($0) }
+
+        autoreleasepool {
+            let balancedURL = NSURL(fileURLWithPath: "/tmp/balanced")
+            counter.add(1, to: balancedURL)
+            counter.add(-1, to: balancedURL)
+
+            let leakedURL = NSURL(fileURLWithPath: "/tmp/leaked")
+            counter.add(2, to: leakedURL)
+        }
+        XCTAssertEqual(leakedAccesses, [])
+
+        let url = NSURL(fileURLWithPath: "/tmp/file")
+        counter.add(1, to: url)
+        XCTAssertEqual(leakedAccesses, [.init(path: "/tmp/leaked", retainCount: 2)])
+
+        // reported once, and not for URLs still alive
+        let otherURL = NSURL(fileURLWithPath: "/tmp/other")
+        counter.add(1, to: otherURL)
+        XCTAssertEqual(leakedAccesses, [.init(path: "/tmp/leaked", retainCount: 2)])
+        XCTAssertEqual(counter.activeURLs().count, 2)
+        withExtendedLifetime((url, otherURL)) {}
+    }
+
+    func testWhenCountersAreUpdatedConcurrentlyThenCountsAreBalanced() {
+        let counter = SandboxExtensionRetainCounter(stripeCount: 4)
+        let urls = (0..<64).map { NSURL(fileURLWithPath: "/tmp/file\($0)") }
+
+        DispatchQueue.concurrentPerform(iterations: 1000) { i in
+            let url = urls[i % urls.count]
+            counter.add(1, to: url)
+            counter.add(1, to: url)
+            counter.add(-1, to: url)
+        }
+
+        XCTAssertEqual(urls.reduce(0) { $0 + counter.retainCount(for: $1) }, 1000)
+        XCTAssertEqual(counter.activeURLs().count, urls.count)
+    }
+
+}
@@ -167,6 +167,24 @@ final class FireTests: XCTestCase {
         waitForExpectations(timeout: 5, handler: nil)
     }
 
+    @MainActor
+    func testWhenBurnAllFinishesThenAllPhasesAreTimed() {
+        let fire = Fire(cacheManager: WebCacheManagerMock(),
+                        historyCoordinating: HistoryCoordinatingMock(),
+                        permissionManager: PermissionManagerMock(),
+                        faviconManagement: FaviconManagerMock(),
+                        tld: ContentBlocking.shared.tld,
+                        getPrivacyStats: { MockPrivacyStats() })
+
+        let burningExpectation = expectation(description: "Burning")
+        fire.burnAll {
+            burningExpectation.fulfill()
+        }
+
+        waitForExpectations(timeout: 5, handler: nil)
+        XCTAssertEqual(Set(fire.lastBurnPhaseDurations.keys), [.tabs, .webCache, .privacyStats, .history, .permissions, .favicons])
+    }
+
     @MainActor
     func testWhenBurnAllIsCalledThenLastSessionStateIsCleared() {
         let fileName = "testStateFileForBurningAllData"
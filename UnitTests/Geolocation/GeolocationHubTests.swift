@@ -0,0 +1,158 @@
+//
+//  GeolocationHubTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Combine
+import CoreLocation
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class GeolocationHubTests: XCTestCase {
+
+    var geolocationServiceMock: GeolocationServiceMock!
+    var hub: GeolocationHub!
+    var cancellables = Set<AnyCancellable>()
+
+    /// Walking trace: (seconds since start, meters north of the start point, horizontal accuracy)
+    static let walkTrace: [(time: TimeInterval, north: Double, accuracy: Double)] = [
+        (0.0, 0.0, 65), (0.2, 0.0, 65), (0.4, 0.1, 30), (0.6, 0.2, 30), (0.8, 0.3, 30),
+        (1.0, 0.4, 30), (1.5, 0.6, 10), (2.0, 0.9, 10), (2.2, 2.5, 10), (2.4, 2.6, 10),
+        (3.0, 3.0, 10), (4.5, 3.1, 10), (4.6, 3.1, 10), (5.0, 9.0, 10),
+    ]
+
+    static func locations(from trace: [(time: TimeInterval, north: Double, accuracy: Double)]) -> [CLLocation] {
+        let start = Date()
+        let metersPerDegree = 111_320.0
+        return trace.map { point in
+            CLLocation(coordinate: CLLocationCoordinate2D(latitude: 40 + point.north / metersPerDegree, longitude: -75),
+                       altitude: 0,
+                       horizontalAccuracy: point.accuracy,
+                       verticalAccuracy: -1,
+                       timestamp: start.addingTimeInterval(point.time))
+        }
+    }
+
+    override func setUp() {
+        geolocationServiceMock = GeolocationServiceMock()
+        hub = GeolocationHub(geolocationService: geolocationServiceMock)
+    }
+
+    override func tearDown() {
+        cancellables.removeAll()
+        hub = nil
+        geolocationServiceMock = nil
+    }
+
+    func replay(_ locations: [CLLocation]) {
+        for location in locations {
+            geolocationServiceMock.currentLocationPublished = .success(location)
+        }
+    }
+
+    func testWhenMultipleSubscribersThenServiceIsSubscribedOnce() {
+        for _ in 0..<5 {
+            hub.subscribe { _ in }.store(in: &cancellables)
+        }
+        XCTAssertEqual(geolocationServiceMock.history, [.subscribed])
+
+        cancellables.removeAll()
+        XCTAssertEqual(geolocationServiceMock.history, [.subscribed, .cancelled])
+    }
+
+    func testWhenLocationTraceIsReplayedThenSamePositionObjectIsSharedBySubscribers() {
+        var positions1 = [GeolocationPosition]()
+        var positions2 = [GeolocationPosition]()
+        hub.subscribe(throttle: .none) { positions1.append(try! $0.get()) }.store(in: &cancellables)
+        hub.subscribe(throttle: .none) { positions2.append(try! $0.get()) }.store(in: &cancellables)
+
+        let locations = Self.locations(from: Self.walkTrace)
+        replay(locations)
+
+        XCTAssertEqual(positions1.count, locations.count)
+        XCTAssertEqual(positions2.count, locations.count)
+        for (position1, position2) in zip(positions1, positions2) {
+            XCTAssertTrue(position1 === position2)
+        }
+        XCTAssertEqual(positions1.map(\.location), locations)
+    }
+
+    func testWhenLocationTraceIsReplayedThenUpdatesAreThrottledPerSubscriber() {
+        var unthrottledCount = 0
+        var defaultCount = 0
+        var coarseLocations = [CLLocation]()
+        hub.subscribe(throttle: .none) { _ in unthrottledCount += 1 }.store(in: &cancellables)
+        hub.subscribe(throttle: .default) { _ in defaultCount += 1 }.store(in: &cancellables)
+        hub.subscribe(throttle: .init(minimumDistance: 5, minimumInterval: 10)) {
+            coarseLocations.append(try! $0.get().location)
+        }.store(in: &cancellables)
+
+        let locations = Self.locations(from: Self.walkTrace)
+        replay(locations)
+
+        XCTAssertEqual(unthrottledCount, 14)
+        // delivered: initial fix, better accuracy at 0.4, 1 s elapsed at 1.5 and 4.5, 1.9 m move at 2.2, 5.9 m move at 5.0
+        XCTAssertEqual(defaultCount, 6)
+        // initial fix, accuracy improvements at 0.4 and 1.5, 9 m move at 5.0
+        XCTAssertEqual(coarseLocations, [locations[0], locations[2], locations[6], locations[13]])
+        XCTAssertEqual(geolocationServiceMock.history.filter { $0 == .subscribed }.count, 1)
+    }
+
+    func testWhenSubscribedAfterLocationReceivedThenLastLocationIsDelivered() {
+        hub.subscribe { _ in }.store(in: &cancellables)
+        let location = CLLocation(latitude: 1, longitude: 2)
+        geolocationServiceMock.currentLocationPublished = .success(location)
+
+        var received: CLLocation?
+        hub.subscribe { received = try? $0.get().location }.store(in: &cancellables)
+
+        XCTAssertEqual(received, location)
+        XCTAssertEqual(geolocationServiceMock.history, [.subscribed, .locationPublished])
+    }
+
+    func testWhenErrorIsReceivedThenItIsDeliveredAndNextLocationIsNotThrottled() {
+        struct TestError: Error {}
+        var results = [Result<CLLocation, Error>]()
+        hub.subscribe(throttle: .init(minimumDistance: 100, minimumInterval: 100)) {
+            results.append($0.map(\.location))
+        }.store(in: &cancellables)
+
+        let location = CLLocation(latitude: 1, longitude: 2)
+        geolocationServiceMock.currentLocationPublished = .success(location)
+        geolocationServiceMock.currentLocationPublished = .failure(TestError())
+        geolocationServiceMock.currentLocationPublished = .success(location)
+
+        XCTAssertEqual(results.count, 3)
+        XCTAssertNil(try? results[1].get())
+        XCTAssertEqual(try? results[2].get(), location)
+    }
+
+    func testWhenHighAccuracyRequestedBySeveralSubscribersThenItIsRequestedOnceUntilLastCancelled() {
+        let request1 = hub.requestHighAccuracy()
+        let request2 = hub.requestHighAccuracy()
+        let request3 = hub.requestHighAccuracy()
+        XCTAssertEqual(geolocationServiceMock.history, [.highAccuracyRequested])
+
+        request1.cancel()
+        request1.cancel()
+        request2.cancel()
+        XCTAssertEqual(geolocationServiceMock.history, [.highAccuracyRequested])
+
+        request3.cancel()
+        XCTAssertEqual(geolocationServiceMock.history, [.highAccuracyRequested, .highAccuracyCancelled])
+    }
+
+}
@@ -26,6 +26,7 @@ import WebKit
 final class GeolocationProviderTests: XCTestCase {
 
     let geolocationServiceMock = GeolocationServiceMock()
+    lazy var geolocationHub = GeolocationHub(geolocationService: geolocationServiceMock)
     let appIsActive = CurrentValueSubject<Bool, Never>(true)
     var windows = [NSWindow]()
     var webViews = [WKWebView]()
@@ -87,7 +88,7 @@ final class GeolocationProviderTests: XCTestCase {
         webViews.append(webView)
 
         let geolocationProvider = GeolocationProvider(processPool: webView.configuration.processPool,
-                                                      geolocationService: geolocationServiceMock,
+                                                      geolocationHub: geolocationHub,
                                                       appIsActivePublisher: appIsActive)
         webView.configuration.processPool.geolocationProvider = geolocationProvider
         webView.configuration.userContentController.add(self, name: "testHandler")
@@ -265,11 +266,13 @@ final class GeolocationProviderTests: XCTestCase {
         let location2 = CLLocation(latitude: 10.1, longitude: -13.5)
 
         geolocationServiceMock.currentLocationPublished = .success(location1)
-        geolocationServiceMock.onSubscriptionReceived = { [geolocationServiceMock] _ in
-            if geolocationServiceMock.history == [.locationPublished, .subscribed, .subscribed] {
-                DispatchQueue.main.async {
-                    geolocationServiceMock.currentLocationPublished = .success(location2)
-                }
+        var location1ReceivedCount = 0
+        // publish location2 once both the web views have received location1 from the shared subscription
+        func location1Received() {
+            location1ReceivedCount += 1
+            guard location1ReceivedCount == 2 else { return }
+            DispatchQueue.main.async { [geolocationServiceMock] in
+                geolocationServiceMock.currentLocationPublished = .success(location2)
             }
         }
 
@@ -282,8 +285,10 @@ final class GeolocationProviderTests: XCTestCase {
             switch (webView, try Response(body)) {
             case (webView1, Response(location1.removingAltitude())):
                 e1_1.fulfill()
+                location1Received()
             case (webView2, Response(location1.removingAltitude())):
                 e1_2.fulfill()
+                location1Received()
             case (webView1, Response(location2.removingAltitude())):
                 e2_1.fulfill()
             case (webView2, Response(location2.removingAltitude())):
@@ -311,11 +316,10 @@ final class GeolocationProviderTests: XCTestCase {
         }
         waitForExpectations(timeout: 3.0)
 
+        // the location is subscribed once for all the web views
         XCTAssertEqual(geolocationServiceMock.history, [.locationPublished,
-                                                        .subscribed,
                                                         .subscribed,
                                                         .locationPublished,
-                                                        .cancelled,
                                                         .cancelled])
     }
 
@@ -386,12 +390,13 @@ final class GeolocationProviderTests: XCTestCase {
         let location2 = CLLocation(latitude: 10.1, longitude: -13.5)
 
         geolocationServiceMock.currentLocationPublished = .success(location1)
-        geolocationServiceMock.onSubscriptionReceived = { [geolocationServiceMock] _ in
-            if geolocationServiceMock.history == [.locationPublished, .subscribed, .subscribed] {
-                DispatchQueue.main.async {
-                    webView2.configuration.processPool.geolocationProvider!.isPaused = true
-                    geolocationServiceMock.currentLocationPublished = .success(location2)
-                }
+        var location1ReceivedCount = 0
+        func location1Received() {
+            location1ReceivedCount += 1
+            guard location1ReceivedCount == 2 else { return }
+            DispatchQueue.main.async { [geolocationServiceMock] in
+                webView2.configuration.processPool.geolocationProvider!.isPaused = true
+                geolocationServiceMock.currentLocationPublished = .success(location2)
             }
         }
 
@@ -403,8 +408,10 @@ final class GeolocationProviderTests: XCTestCase {
             switch (webView, try Response(body)) {
             case (webView1, Response(location1.removingAltitude())):
                 e1_1.fulfill()
+                location1Received()
             case (webView2, Response(location1.removingAltitude())):
                 e1_2.fulfill()
+                location1Received()
             case (webView1, Response(location2.removingAltitude())):
                 e2_1.fulfill()
             case (webView2, Response(location2.removingAltitude())):
@@ -434,8 +441,6 @@ final class GeolocationProviderTests: XCTestCase {
 
         XCTAssertEqual(geolocationServiceMock.history, [.locationPublished,
                                                         .subscribed,
-                                                        .subscribed,
-                                                        .cancelled,
                                                         .locationPublished,
                                                         .cancelled])
     }
@@ -335,6 +335,27 @@ final class HistoryGroupingProviderTests: XCTestCase {
         ])
     }
 
+    func testThatVisitGroupingsAreKeyedByStartOfDay() throws {
+        featureFlagger.isFeatureOn = true
+
+        let date = Date.noonToday
+        dataSource.history = [
+            .make(url: "https://example.com".url!, visits: [
+                Visit(date: date),
+                Visit(date: date.daysAgo(2))
+            ]),
+            .make(url: "https://example.com/index2.html".url!, visits: [
+                Visit(date: date.addingTimeInterval(-1)),
+                Visit(date: date.daysAgo(2).addingTimeInterval(-1))
+            ])
+        ]
+
+        let groupings = provider.getVisitGroupings()
+
+        XCTAssertEqual(groupings.map(\.date), [date.startOfDay, date.daysAgo(2).startOfDay])
+        XCTAssertEqual(groupings.map(\.visits.count), [2, 2])
+    }
+
     // MARK: - getVisitGroupings without deduplication
 
     func testWhenHistoryViewIsDisabledThenVisitGroupingsAreNotDeduplicated() throws {
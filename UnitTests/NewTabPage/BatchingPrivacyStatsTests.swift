@@ -0,0 +1,171 @@
+//
+//  BatchingPrivacyStatsTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Combine
+import PrivacyStats
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+private final class CountingPrivacyStats: PrivacyStatsCollecting {
+
+    let statsUpdateSubject = PassthroughSubject<Void, Never>()
+    var statsUpdatePublisher: AnyPublisher<Void, Never> { statsUpdateSubject.eraseToAnyPublisher() }
+
+    var stats = [String: Int64]()
+    var fetchCount = 0
+    var recordCount = 0
+    var didHandleAppTermination = false
+    /// called when a tracker is being recorded, before it‘s counted
+    var onRecordBlockedTracker: (() async -> Void)?
+
+    func recordBlockedTracker(_ name: String) async {
+        recordCount += 1
+        await onRecordBlockedTracker?()
+        stats[name, default: 0] += 1
+    }
+
+    func fetchPrivacyStats() async -> [String: Int64] {
+        fetchCount += 1
+        return stats
+    }
+
+    func clearPrivacyStats() async {
+        stats = [:]
+    }
+
+    func handleAppTermination() async {
+        didHandleAppTermination = true
+    }
+
+}
+
+final class BatchingPrivacyStatsTests: XCTestCase {
+
+    private var store: CountingPrivacyStats!
+    private var privacyStats: BatchingPrivacyStats!
+    private var now = Date()
+
+    override func setUp() {
+        store = CountingPrivacyStats()
+        privacyStats = BatchingPrivacyStats(store: store, flushInterval: 3600, currentDate: { [unowned self] in now })
+    }
+
+    override func tearDown() {
+        privacyStats = nil
+        store = nil
+    }
+
+    func testWhenTrackersAreRecordedThenTheyAreCountedBeforeFlush() async {
+        privacyStats.countBlockedTracker("Tracker A")
+        privacyStats.countBlockedTracker("Tracker A")
+        await privacyStats.recordBlockedTracker("Tracker B")
+
+        XCTAssertEqual(store.stats, [:])
+        let stats = await privacyStats.fetchPrivacyStats()
+        XCTAssertEqual(stats, ["Tracker A": 2, "Tracker B": 1])
+    }
+
+    func testWhenFlushedThenCountsAreRecordedInStore() async {
+        privacyStats.countBlockedTracker("Tracker A")
+        privacyStats.countBlockedTracker("Tracker A")
+        privacyStats.countBlockedTracker("Tracker B")
+
+        await privacyStats.flush()
+
+        XCTAssertEqual(store.stats, ["Tracker A": 2, "Tracker B": 1])
+        XCTAssertEqual(store.recordCount, 3)
+        let stats = await privacyStats.fetchPrivacyStats()
+        XCTAssertEqual(stats, ["Tracker A": 2, "Tracker B": 1])
+    }
+
+    func testWhenStatsAreFetchedDuringFlushThenCountsAreNotCountedTwice() async {
+        privacyStats.countBlockedTracker("Tracker A")
+        let fetchStarted = expectation(description: "fetch started")
+        var fetchedStats: Task<[String: Int64], Never>?
+        store.onRecordBlockedTracker = { [unowned self] in
+            fetchedStats = Task { await self.privacyStats.fetchPrivacyStats() }
+            fetchStarted.fulfill()
+        }
+
+        await privacyStats.flush()
+        await fulfillment(of: [fetchStarted], timeout: 1)
+
+        let stats = await fetchedStats?.value
+        XCTAssertEqual(stats, ["Tracker A": 1])
+    }
+
+    func testWhenStatsAreClearedDuringFlushThenFlushedCountsAreDropped() async {
+        privacyStats.countBlockedTracker("Tracker A")
+        let clearStarted = expectation(description: "clear started")
+        var clearTask: Task<Void, Never>?
+        store.onRecordBlockedTracker = { [unowned self] in
+            // clear while the counts are being written
+            clearTask = Task { await self.privacyStats.clearPrivacyStats() }
+            clearStarted.fulfill()
+        }
+
+        await privacyStats.flush()
+        await fulfillment(of: [clearStarted], timeout: 1)
+        await clearTask?.value
+
+        XCTAssertEqual(store.stats, [:])
+        let stats = await privacyStats.fetchPrivacyStats()
+        XCTAssertEqual(stats, [:])
+
+        // counts collected after the clear are kept
+        store.onRecordBlockedTracker = nil
+        privacyStats.countBlockedTracker("Tracker B")
+        await privacyStats.flush()
+        XCTAssertEqual(store.stats, ["Tracker B": 1])
+    }
+
+    func testThatStatsAreFetchedFromStoreAgainOnlyAfterUpdateOrDayChange() async {
+        _ = await privacyStats.fetchPrivacyStats()
+        _ = await privacyStats.fetchPrivacyStats()
+        XCTAssertEqual(store.fetchCount, 1)
+
+        store.statsUpdateSubject.send()
+        _ = await privacyStats.fetchPrivacyStats()
+        XCTAssertEqual(store.fetchCount, 2)
+
+        now = now.addingTimeInterval(24 * 60 * 60)
+        _ = await privacyStats.fetchPrivacyStats()
+        XCTAssertEqual(store.fetchCount, 3)
+    }
+
+    func testWhenStatsAreClearedThenPendingCountsAreDropped() async {
+        privacyStats.countBlockedTracker("Tracker A")
+
+        await privacyStats.clearPrivacyStats()
+        await privacyStats.flush()
+
+        XCTAssertEqual(store.stats, [:])
+        let stats = await privacyStats.fetchPrivacyStats()
+        XCTAssertEqual(stats, [:])
+    }
+
+    func testWhenAppTerminatesThenPendingCountsAreFlushed() async {
+        privacyStats.countBlockedTracker("Tracker A")
+
+        await privacyStats.handleAppTermination()
+
+        XCTAssertEqual(store.stats, ["Tracker A": 1])
+        XCTAssertTrue(store.didHandleAppTermination)
+    }
+
+}
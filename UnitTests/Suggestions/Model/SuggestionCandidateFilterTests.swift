@@ -0,0 +1,73 @@
+//
+//  SuggestionCandidateFilterTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class SuggestionCandidateFilterTests: XCTestCase {
+
+    private let corpus = [
+        "DuckDuckGo — Privacy, simplified. https://duckduckgo.com/",
+        "Café Menu https://example.com/cafe",
+        "Spread Privacy https://spreadprivacy.com/",
+        "Example Domain https://example.com/",
+    ]
+
+    private var sourceCallCount = 0
+    private lazy var filter = SuggestionCandidateFilter<String> { $0 }
+
+    private func candidates(matching query: String) -> [String] {
+        filter.candidates(matching: query) {
+            sourceCallCount += 1
+            return corpus
+        }
+    }
+
+    func testWhenQueryIsEmptyThenAllCandidatesAreReturned() {
+        XCTAssertEqual(candidates(matching: " "), corpus)
+    }
+
+    func testThatCandidatesMustContainAllQueryTokensIgnoringCaseAndDiacritics() {
+        XCTAssertEqual(candidates(matching: "PRIVACY"), [corpus[0], corpus[2]])
+        XCTAssertEqual(candidates(matching: "privacy spread"), [corpus[2]])
+        XCTAssertEqual(candidates(matching: "cafe"), [corpus[1]])
+        XCTAssertEqual(candidates(matching: "example.com/"), [corpus[1], corpus[3]])
+    }
+
+    func testWhenQueryExtendsPreviousQueryThenPreviousCandidatesAreNarrowed() {
+        XCTAssertEqual(candidates(matching: "d"), [corpus[0], corpus[2], corpus[3]])
+        XCTAssertEqual(candidates(matching: "du"), [corpus[0]])
+        XCTAssertEqual(candidates(matching: "duc"), [corpus[0]])
+        XCTAssertEqual(sourceCallCount, 1)
+    }
+
+    func testWhenQueryDoesNotExtendPreviousQueryThenAllCandidatesAreFilteredAgain() {
+        XCTAssertEqual(candidates(matching: "duc"), [corpus[0]])
+        XCTAssertEqual(candidates(matching: "du"), [corpus[0]])
+        XCTAssertEqual(candidates(matching: "ex"), [corpus[1], corpus[3]])
+        XCTAssertEqual(sourceCallCount, 3)
+    }
+
+    func testWhenFilterIsResetThenAllCandidatesAreFilteredAgain() {
+        XCTAssertEqual(candidates(matching: "d"), [corpus[0], corpus[2], corpus[3]])
+        filter.reset()
+        XCTAssertEqual(candidates(matching: "du"), [corpus[0]])
+        XCTAssertEqual(sourceCallCount, 2)
+    }
+
+}
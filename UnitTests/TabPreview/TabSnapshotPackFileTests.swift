@@ -0,0 +1,196 @@
+//
+//  TabSnapshotPackFileTests.swift
+//
+//  Copyright © 2025 DuckDuckGo. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+@testable import DuckDuckGo_Privacy_Browser
+
+final class TabSnapshotPackFileTests: XCTestCase {
+
+    var directoryURL: URL!
+
+    override func setUp() {
+        directoryURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try? FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directoryURL)
+        directoryURL = nil
+    }
+
+    private func makePackFile() -> TabSnapshotPackFile {
+        TabSnapshotPackFile.shared(at: directoryURL.appendingPathComponent(UUID().uuidString + ".pack"))
+    }
+
+    /// Opens a copy of the pack file so its index is read from the disk.
+    private func reopen(_ packFile: TabSnapshotPackFile) throws -> TabSnapshotPackFile {
+        let copyURL = directoryURL.appendingPathComponent(UUID().uuidString + ".pack")
+        try FileManager.default.copyItem(at: packFile.url, to: copyURL)
+        return TabSnapshotPackFile.shared(at: copyURL)
+    }
+
+    private func fileSize(of packFile: TabSnapshotPackFile) -> Int {
+        (try? FileManager.default.attributesOfItem(atPath: packFile.url.path)[.size] as? Int) ?? 0
+    }
+
+    func testWhenSnapshotIsWrittenThenItCanBeRead() {
+        let packFile = makePackFile()
+        let id = UUID()
+
+        packFile.queue.sync {
+            XCTAssertTrue(packFile.write("snapshot".utf8data, id: id))
+            XCTAssertEqual(packFile.read(id: id), "snapshot".utf8data)
+            XCTAssertEqual(packFile.ids, [id])
+        }
+    }
+
+    func testWhenSnapshotIsReplacedOrRemovedThenLatestStateIsRestoredFromDisk() throws {
+        let packFile = makePackFile()
+        let replacedId = UUID()
+        let removedId = UUID()
+
+        try packFile.queue.sync {
+            packFile.write("old".utf8data, id: replacedId)
+            packFile.write("removed".utf8data, id: removedId)
+            packFile.write("new".utf8data, id: replacedId)
+            packFile.remove(id: removedId)
+            XCTAssertGreaterThan(packFile.garbageByteCount, 0)
+
+            let reopened = try reopen(packFile)
+            reopened.queue.sync {
+                XCTAssertEqual(reopened.ids, [replacedId])
+                XCTAssertEqual(reopened.read(id: replacedId), "new".utf8data)
+                XCTAssertNil(reopened.read(id: removedId))
+                XCTAssertEqual(reopened.garbageByteCount, packFile.garbageByteCount)
+            }
+        }
+    }
+
+    func testWhenLastRecordIsTruncatedThenItIsDiscarded() throws {
+        let packFile = makePackFile()
+        let id = UUID()
+        let truncatedId = UUID()
+
+        try packFile.queue.sync {
+            packFile.write("complete".utf8data, id: id)
+            packFile.write("truncated".utf8data, id: truncatedId)
+            let fileHandle = try FileHandle(forUpdating: packFile.url)
+            try fileHandle.truncate(atOffset: UInt64(fileSize(of: packFile) - 3))
+            try fileHandle.close()
+
+            let reopened = try reopen(packFile)
+            reopened.queue.sync {
+                XCTAssertEqual(reopened.ids, [id])
+                XCTAssertEqual(reopened.read(id: id), "complete".utf8data)
+                // new records are appended after the last complete one
+                XCTAssertTrue(reopened.write("rewritten".utf8data, id: truncatedId))
+                XCTAssertEqual(reopened.read(id: truncatedId), "rewritten".utf8data)
+            }
+        }
+    }
+
+    func testWhenPackFileIsCompactedThenOnlyKeptSnapshotsRemainAndFileShrinks() throws {
+        let packFile = makePackFile()
+        let keptId = UUID()
+        let droppedId = UUID()
+
+        try packFile.queue.sync {
+            packFile.write(Data(repeating: 1, count: 1000), id: keptId)
+            packFile.write(Data(repeating: 2, count: 1000), id: keptId)
+            packFile.write(Data(repeating: 3, count: 1000), id: droppedId)
+            let sizeBeforeCompaction = fileSize(of: packFile)
+
+            XCTAssertTrue(packFile.compact(keeping: [keptId]))
+
+            XCTAssertLessThan(fileSize(of: packFile), sizeBeforeCompaction)
+            XCTAssertEqual(packFile.garbageByteCount, 0)
+            XCTAssertEqual(packFile.ids, [keptId])
+            XCTAssertEqual(packFile.read(id: keptId), Data(repeating: 2, count: 1000))
+
+            let reopened = try reopen(packFile)
+            reopened.queue.sync {
+                XCTAssertEqual(reopened.ids, [keptId])
+                XCTAssertEqual(reopened.read(id: keptId), Data(repeating: 2, count: 1000))
+            }
+        }
+    }
+
+    func testWhenSnapshotIsRemovedThenItsPayloadsAreErasedFromFile() throws {
+        let packFile = makePackFile()
+        let removedId = UUID()
+        let keptId = UUID()
+
+        try packFile.queue.sync {
+            packFile.write("first screenshot".utf8data, id: removedId)
+            packFile.write("kept screenshot".utf8data, id: keptId)
+            packFile.write("second screenshot".utf8data, id: removedId)
+
+            XCTAssertTrue(packFile.remove(id: removedId))
+
+            let fileData = try Data(contentsOf: packFile.url)
+            XCTAssertNil(fileData.range(of: "first screenshot".utf8data))
+            XCTAssertNil(fileData.range(of: "second screenshot".utf8data))
+            XCTAssertEqual(packFile.read(id: keptId), "kept screenshot".utf8data)
+
+            let reopened = try reopen(packFile)
+            reopened.queue.sync {
+                XCTAssertEqual(reopened.ids, [keptId])
+                XCTAssertEqual(reopened.read(id: keptId), "kept screenshot".utf8data)
+            }
+        }
+    }
+
+    func testWhenSnapshotIsClearedThenItsPayloadIsGoneFromFile() async throws {
+        let packFileURL = directoryURL.appendingPathComponent(UUID().uuidString + ".pack")
+        let store = TabSnapshotStore(fileStore: FileStoreMock(), packFileURL: packFileURL)
+        let tabID = UUID()
+        let snapshot = NSImage(size: NSSize(width: 100, height: 100), flipped: false) { rect in
+            NSColor.red.setFill()
+            rect.fill()
+            return true
+        }
+
+        store.persistSnapshot(snapshot, id: tabID)
+        let storedIds = await store.loadAllStoredSnapshotIds()
+        XCTAssertEqual(storedIds, [tabID])
+        let pngSignature = Data([0x89, 0x50, 0x4E, 0x47])
+        XCTAssertNotNil(try Data(contentsOf: packFileURL).range(of: pngSignature))
+
+        store.clearSnapshot(tabID: tabID)
+        let remainingIds = await store.loadAllStoredSnapshotIds()
+
+        XCTAssertEqual(remainingIds, [])
+        XCTAssertNil(try Data(contentsOf: packFileURL).range(of: pngSignature))
+    }
+
+    func testWhenSnapshotIsEncodedThenItIsDownscaledToMaxWidth() throws {
+        let context = try XCTUnwrap(CGContext(data: nil, width: 1200, height: 800, bitsPerComponent: 8, bytesPerRow: 0,
+                                              space: CGColorSpaceCreateDeviceRGB(),
+                                              bitmapInfo: CGImageAlphaInfo.premultipliedFirst.rawValue))
+        context.setFillColor(NSColor.red.cgColor)
+        context.fill(CGRect(x: 0, y: 0, width: 1200, height: 800))
+        let image = try XCTUnwrap(context.makeImage())
+
+        let data = try XCTUnwrap(TabSnapshotStore.encode(image, maxPixelWidth: 600))
+        let decoded = try XCTUnwrap(TabSnapshotStore.decode(data))
+
+        XCTAssertEqual(decoded.width, 600)
+        XCTAssertEqual(decoded.height, 400)
+    }
+
+}